@@ -35,14 +35,14 @@ BranchSwitchInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
       LOG_DEBUG("Searching end of block label for: " << startBasicBlockLabel);
 
       const auto endBasicBlock = DataFlowUtils::getEndOfTaintedBlock(startBasicBlock);
-      const auto endBasicBlockLabel = endBasicBlock ? endBasicBlock->getName() : "";
 
-      LOG_DEBUG("End of block label: " << endBasicBlockLabel);
+      LOG_DEBUG("End of block label: " << (endBasicBlock ? endBasicBlock->getName() : ""));
 
       ExtendedValue ev(currentInst);
-      ev.setEndOfTaintedBlockLabel(endBasicBlockLabel);
+      ev.setEndOfTaintedBlockLabel(DataFlowUtils::getEndOfTaintedBlockLabel(endBasicBlock));
 
       traceStats.add(currentInst);
+      if (DataFlowUtils::isCompactTaintedBlocks()) traceStats.addTaintedBlock(startBasicBlock, endBasicBlock);
 
       return { fact, ev };
     }
@@ -51,4 +51,6 @@ BranchSwitchInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<BranchSwitchInstFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class BranchSwitchInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<BranchSwitchInstFlowFunction>
 {
 public:
   BranchSwitchInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~BranchSwitchInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<BranchSwitchInstFlowFunction>;
+
 } // namespace
 
 #endif // BRANCHSWITCHINSTFLOWFUNCTION_H
@@ -4,18 +4,22 @@
 
 #include "CallToRetFlowFunction.h"
 
-#include <llvm/IR/IntrinsicInst.h>
-
 namespace psr {
 
 std::set<ExtendedValue>
 CallToRetFlowFunction::computeTargetsExt(ExtendedValue& fact)
 {
   /*
-   * Kill every global and expect the callee to return all valid ones.
+   * Kill every global that is passed to a callee and expect the callee to
+   * return all valid ones. Globals no callee can reference bypass the call.
    */
-  bool isGlobalMemLocationFact = DataFlowUtils::isGlobalMemoryLocationSeq(DataFlowUtils::getMemoryLocationSeqFromFact(fact));
-  if (isGlobalMemLocationFact) return { };
+  const auto factMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromFact(fact);
+
+  bool isGlobalMemLocationFact = DataFlowUtils::isGlobalMemoryLocationSeq(factMemLocationSeq);
+  if (isGlobalMemLocationFact) {
+    bool isPassedGlobal = isReferencedGlobal(llvm::cast<llvm::GlobalVariable>(factMemLocationSeq.front()));
+    if (isPassedGlobal) return { };
+  }
 
   /*
    * For functions that kill facts and are handled in getSummaryFlowFunction()
@@ -24,14 +28,25 @@ CallToRetFlowFunction::computeTargetsExt(ExtendedValue& fact)
    * e.g. through identity function.
    *
    * Need to keep the list in sync with "killing" functions in getSummaryFlowFunction()!
+   * (see getCallToRetFlowFunction())
    */
-  bool isHandledInSummaryFlowFunction = llvm::isa<llvm::MemTransferInst>(currentInst) ||
-                                        llvm::isa<llvm::MemSetInst>(currentInst) ||
-                                        llvm::isa<llvm::VAEndInst>(currentInst);
-
   if (isHandledInSummaryFlowFunction) return { };
 
   return { fact };
 }
 
+bool
+CallToRetFlowFunction::isReferencedGlobal(const llvm::GlobalVariable* global) const
+{
+  if (callees.empty()) return true;
+
+  for (const auto callee : callees) {
+    if (globalModRefTable.mayReference(callee, global)) return true;
+  }
+
+  return false;
+}
+
+template class FlowFunctionBase<CallToRetFlowFunction>;
+
 } // namespace
@@ -7,21 +7,40 @@
 
 #include "FlowFunctionBase.h"
 
+#include "../Utils/GlobalModRefTable.h"
+
+#include <set>
+
 namespace psr {
 
 class CallToRetFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<CallToRetFlowFunction>
 {
 public:
   CallToRetFlowFunction(const llvm::Instruction* _currentInst,
+                        bool _isHandledInSummaryFlowFunction,
+                        const std::set<const llvm::Function*>& _callees,
+                        const GlobalModRefTable& _globalModRefTable,
                         TraceStats& _traceStats,
                         ExtendedValue _zeroValue) :
-    FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
+    FlowFunctionBase(_currentInst, _traceStats, _zeroValue),
+    isHandledInSummaryFlowFunction(_isHandledInSummaryFlowFunction),
+    callees(_callees),
+    globalModRefTable(_globalModRefTable) { }
   ~CallToRetFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
+
+private:
+  bool isReferencedGlobal(const llvm::GlobalVariable* global) const;
+
+  bool isHandledInSummaryFlowFunction;
+  const std::set<const llvm::Function*> callees;
+  const GlobalModRefTable& globalModRefTable;
 };
 
+extern template class FlowFunctionBase<CallToRetFlowFunction>;
+
 } // namespace
 
 #endif // CALLTORETFLOWFUNCTION_H
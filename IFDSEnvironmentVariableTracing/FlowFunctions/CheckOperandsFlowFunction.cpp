@@ -25,4 +25,6 @@ CheckOperandsFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<CheckOperandsFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class CheckOperandsFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<CheckOperandsFlowFunction>
 {
 public:
   CheckOperandsFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~CheckOperandsFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<CheckOperandsFlowFunction>;
+
 } // namespace
 
 #endif // CHECKOPERANDSFLOWFUNCTION_H
@@ -0,0 +1,23 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "ComposeFlowFunction.h"
+
+namespace psr {
+
+std::set<ExtendedValue>
+ComposeFlowFunction::computeTargets(ExtendedValue fact)
+{
+  std::set<ExtendedValue> targetFacts;
+
+  for (const auto& intermediateFact : first->computeTargets(fact)) {
+    const auto secondTargetFacts = second->computeTargets(intermediateFact);
+
+    targetFacts.insert(secondTargetFacts.begin(), secondTargetFacts.end());
+  }
+
+  return targetFacts;
+}
+
+} // namespace
@@ -0,0 +1,39 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef COMPOSEFLOWFUNCTION_H
+#define COMPOSEFLOWFUNCTION_H
+
+#include <memory>
+
+#include <phasar/PhasarLLVM/Domain/ExtendedValue.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+
+namespace psr {
+
+/*
+ * Applies the first flow function and then the second one to every resulting
+ * fact. Used for edges where we need to evaluate two instructions at once.
+ */
+class ComposeFlowFunction :
+    public FlowFunction<ExtendedValue>
+{
+public:
+  ComposeFlowFunction(std::shared_ptr<FlowFunction<ExtendedValue>> _first,
+                      std::shared_ptr<FlowFunction<ExtendedValue>> _second) :
+    first(_first),
+    second(_second) { }
+  ~ComposeFlowFunction() override = default;
+
+  std::set<ExtendedValue>
+  computeTargets(ExtendedValue fact) override;
+
+private:
+  std::shared_ptr<FlowFunction<ExtendedValue>> first;
+  std::shared_ptr<FlowFunction<ExtendedValue>> second;
+};
+
+} // namespace
+
+#endif // COMPOSEFLOWFUNCTION_H
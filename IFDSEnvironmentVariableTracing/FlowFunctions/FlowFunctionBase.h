@@ -18,27 +18,65 @@
 
 namespace psr {
 
-class FlowFunctionBase :
+/*
+ * Part of the instruction flow functions that does not depend on the kind of
+ * flow function: handling of facts that have been added by a tainted branch.
+ */
+class FlowFunctionCommon :
     public FlowFunction<ExtendedValue>
 {
 public:
-  FlowFunctionBase(const llvm::Instruction* _currentInst,
-                   TraceStats& _traceStats,
-                   ExtendedValue _zeroValue) :
+  FlowFunctionCommon(const llvm::Instruction* _currentInst,
+                     TraceStats& _traceStats,
+                     ExtendedValue _zeroValue) :
     currentInst(_currentInst),
     traceStats(_traceStats),
     zeroValue(_zeroValue) { }
-  ~FlowFunctionBase() override = default;
-
-  std::set<ExtendedValue> computeTargets(ExtendedValue fact) override;
-  virtual std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) = 0;
+  ~FlowFunctionCommon() override = default;
 
 protected:
+  std::set<ExtendedValue> computeBranchOrSwitchFactTargets(ExtendedValue& fact);
+
   const llvm::Instruction* currentInst;
   TraceStats& traceStats;
   ExtendedValue zeroValue;
 };
 
+/*
+ * Every instruction flow function derives from FlowFunctionBase<Self>. This
+ * way the kind specific computeTargetsExt() is not another virtual call and
+ * can be inlined into computeTargets(). The template is instantiated in the
+ * translation unit of each flow function.
+ */
+template<typename FlowFunctionImpl>
+class FlowFunctionBase :
+    public FlowFunctionCommon
+{
+public:
+  FlowFunctionBase(const llvm::Instruction* _currentInst,
+                   TraceStats& _traceStats,
+                   ExtendedValue _zeroValue) :
+    FlowFunctionCommon(_currentInst, _traceStats, _zeroValue) { }
+  ~FlowFunctionBase() override = default;
+
+  std::set<ExtendedValue> computeTargets(ExtendedValue fact) override final;
+};
+
+template<typename FlowFunctionImpl>
+std::set<ExtendedValue>
+FlowFunctionBase<FlowFunctionImpl>::computeTargets(ExtendedValue fact)
+{
+  bool isAutoIdentity = DataFlowUtils::isAutoIdentity(currentInst, fact);
+  if (isAutoIdentity) return { fact };
+
+  bool isBranchOrSwitchFact = llvm::isa<llvm::BranchInst>(fact.getValue()) ||
+                              llvm::isa<llvm::SwitchInst>(fact.getValue());
+
+  if (isBranchOrSwitchFact) return computeBranchOrSwitchFactTargets(fact);
+
+  return static_cast<FlowFunctionImpl*>(this)->computeTargetsExt(fact);
+}
+
 } // namespace
 
 #endif // FLOWFUNCTIONBASE_H
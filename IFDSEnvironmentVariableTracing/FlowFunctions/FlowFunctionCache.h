@@ -0,0 +1,76 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef FLOWFUNCTIONCACHE_H
+#define FLOWFUNCTIONCACHE_H
+
+#include "../Utils/Log.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <phasar/PhasarLLVM/Domain/ExtendedValue.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+
+namespace psr {
+
+/*
+ * The solver asks for the flow function of the same edge over and over again.
+ * Our flow functions do not carry any state besides their edge so we create
+ * them once per edge and hand out the same instance afterwards.
+ */
+template<typename Key>
+class FlowFunctionCache
+{
+public:
+  using FlowFunctionPtr = std::shared_ptr<FlowFunction<ExtendedValue>>;
+
+  FlowFunctionCache(std::string _name) :
+    name(_name) { }
+  ~FlowFunctionCache() = default;
+
+  template<typename FlowFunctionFactory>
+  FlowFunctionPtr get(const Key& key,
+                      FlowFunctionFactory createFlowFunction)
+  {
+    const auto flowFunctionEntry = flowFunctions.find(key);
+    if (flowFunctionEntry != flowFunctions.end()) {
+      ++hits;
+
+      return flowFunctionEntry->second;
+    }
+
+    ++misses;
+
+    const FlowFunctionPtr flowFunction = createFlowFunction();
+    flowFunctions.insert({ key, flowFunction });
+
+    return flowFunction;
+  }
+
+  void logStats() const
+  {
+    LOG_INFO(name << " flow function cache: " << hits << " hits, "
+                                              << misses << " misses");
+  }
+
+  std::size_t size() const
+  {
+    return flowFunctions.size();
+  }
+
+private:
+  std::string name;
+
+  std::map<Key, FlowFunctionPtr> flowFunctions;
+
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+};
+
+} // namespace
+
+#endif // FLOWFUNCTIONCACHE_H
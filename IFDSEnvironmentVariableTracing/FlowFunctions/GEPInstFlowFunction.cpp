@@ -14,12 +14,14 @@ GEPInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
 
   bool isVarArgFact = fact.isVarArg();
   if (isVarArgFact) {
-    bool killFact = gepInstPtr->getName().contains_lower("reg_save_area");
+    const auto varArgRole = DataFlowUtils::getVarArgRole(gepInst);
+
+    bool killFact = varArgRole == VarArgRole::REG_SAVE_AREA;
     if (killFact) return { };
 
-    bool incrementCurrentVarArgIndex = gepInst->getName().contains_lower("overflow_arg_area.next");
+    bool incrementCurrentVarArgIndex = varArgRole == VarArgRole::OVERFLOW_ARG_AREA_NEXT;
     if (incrementCurrentVarArgIndex) {
-      const auto gepVaListMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(gepInstPtr);
+      const auto& gepVaListMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(gepInstPtr);
 
       bool isVaListEqual = DataFlowUtils::isSubsetMemoryLocationSeq(DataFlowUtils::getVaListMemoryLocationSeqFromFact(fact),
                                                                     gepVaListMemLocationSeq);
@@ -39,4 +41,6 @@ GEPInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<GEPInstFlowFunction>;
+
 } // namespace
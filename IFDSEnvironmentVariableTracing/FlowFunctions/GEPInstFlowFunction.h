@@ -10,7 +10,7 @@
 namespace psr {
 
 class GEPInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<GEPInstFlowFunction>
 {
 public:
   GEPInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~GEPInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<GEPInstFlowFunction>;
+
 } // namespace
 
 #endif // GEPINSTFLOWFUNCTION_H
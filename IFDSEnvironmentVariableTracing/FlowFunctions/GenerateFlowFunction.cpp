@@ -16,4 +16,6 @@ GenerateFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<GenerateFlowFunction>;
+
 } // namespace
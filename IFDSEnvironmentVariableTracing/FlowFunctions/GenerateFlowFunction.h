@@ -10,7 +10,7 @@
 namespace psr {
 
 class GenerateFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<GenerateFlowFunction>
 {
 public:
   GenerateFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~GenerateFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<GenerateFlowFunction>;
+
 } // namespace
 
 #endif // GENERATEFLOWFUNCTION_H
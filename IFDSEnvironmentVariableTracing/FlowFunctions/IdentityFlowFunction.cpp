@@ -12,4 +12,6 @@ IdentityFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<IdentityFlowFunction>;
+
 } // namespace
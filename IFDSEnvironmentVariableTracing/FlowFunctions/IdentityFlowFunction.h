@@ -10,7 +10,7 @@
 namespace psr {
 
 class IdentityFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<IdentityFlowFunction>
 {
 public:
   IdentityFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~IdentityFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<IdentityFlowFunction>;
+
 } // namespace
 
 #endif // IDENTITYFLOWFUNCTION_H
@@ -8,7 +8,7 @@
 #include "../Utils/Log.h"
 
 #include <algorithm>
-#include <tuple>
+#include <cstddef>
 
 #include <phasar/Utils/LLVMShorthands.h>
 
@@ -23,34 +23,63 @@ MapTaintedValuesToCallee::computeTargets(ExtendedValue fact)
   std::set<ExtendedValue> targetGlobalFacts;
   std::set<ExtendedValue> targetParamFacts;
 
-  bool isGlobalMemLocationFact = DataFlowUtils::isGlobalMemoryLocationSeq(DataFlowUtils::getMemoryLocationSeqFromFact(fact));
-  if (isGlobalMemLocationFact) targetGlobalFacts.insert(fact);
+  const auto globalMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromFact(fact);
+
+  /*
+   * Only pass globals the callee (or one of its callees) may reference. All
+   * others are kept in getCallToRetFlowFunction().
+   */
+  bool isGlobalMemLocationFact = DataFlowUtils::isGlobalMemoryLocationSeq(globalMemLocationSeq);
+  if (isGlobalMemLocationFact) {
+    bool isReferencedGlobal = globalModRefTable.mayReference(destMthd,
+                                                             llvm::cast<llvm::GlobalVariable>(globalMemLocationSeq.front()));
+    if (isReferencedGlobal) targetGlobalFacts.insert(fact);
+  }
+
+  bool isVarArgFact = fact.isVarArg();
+
+  const auto factMemLocationSeq = isVarArgFact ? DataFlowUtils::getVaListMemoryLocationSeqFromFact(fact) :
+                                                 DataFlowUtils::getMemoryLocationSeqFromFact(fact);
 
-  long varArgIndex = 0L;
+  const auto& sanitizedArgList = DataFlowUtils::getSanitizedArgList(callInst, destMthd, zeroValue.getValue());
+
+  /*
+   * Only args that share the memory location frame of the fact or that are
+   * the value of the fact can be tainted by it.
+   */
+  std::set<std::size_t> argIndices;
+
+  if (!factMemLocationSeq.empty()) {
+    const auto memLocationFrameArgIndicesEntry = sanitizedArgList.memLocationFrameArgIndices.find(factMemLocationSeq.front());
+    if (memLocationFrameArgIndicesEntry != sanitizedArgList.memLocationFrameArgIndices.end()) {
+      argIndices.insert(memLocationFrameArgIndicesEntry->second.begin(),
+                        memLocationFrameArgIndicesEntry->second.end());
+    }
+  }
 
-  const auto sanitizedArgList = DataFlowUtils::getSanitizedArgList(callInst, destMthd, zeroValue.getValue());
+  const auto valueArgIndicesEntry = sanitizedArgList.valueArgIndices.find(fact.getValue());
+  if (valueArgIndicesEntry != sanitizedArgList.valueArgIndices.end()) {
+    argIndices.insert(valueArgIndicesEntry->second.begin(),
+                      valueArgIndicesEntry->second.end());
+  }
 
-  for (const auto& argParamTriple : sanitizedArgList) {
+  for (const auto argIndex : argIndices) {
+    const auto& sanitizedArg = sanitizedArgList.args[argIndex];
 
-    const auto arg = std::get<0>(argParamTriple);
-    const auto argMemLocationSeq = std::get<1>(argParamTriple);
-    const auto param = std::get<2>(argParamTriple);
+    const auto arg = sanitizedArg.arg;
+    const auto argMemLocationSeq = sanitizedArg.argMemLocationSeq;
+    const auto param = sanitizedArg.param;
 
     bool isVarArgParam = DataFlowUtils::isVarArgParam(param, zeroValue.getValue());
-    bool isVarArgFact = fact.isVarArg();
 
     bool isArgMemLocation = !argMemLocationSeq.empty();
     if (isArgMemLocation) {
-
-      const auto factMemLocationSeq = isVarArgFact ? DataFlowUtils::getVaListMemoryLocationSeqFromFact(fact) :
-                                                     DataFlowUtils::getMemoryLocationSeqFromFact(fact);
-
       bool genFact = DataFlowUtils::isSubsetMemoryLocationSeq(argMemLocationSeq,
                                                               factMemLocationSeq);
       if (genFact) {
         const auto relocatableMemLocationSeq = DataFlowUtils::getRelocatableMemoryLocationSeq(factMemLocationSeq,
                                                                                               argMemLocationSeq);
-        std::vector<const llvm::Value*> patchablePart{ param };
+        const llvm::ArrayRef<const llvm::Value*> patchablePart(param);
         const auto patchableMemLocationSeq = DataFlowUtils::joinMemoryLocationSeqs(patchablePart,
                                                                                    relocatableMemLocationSeq);
 
@@ -62,7 +91,7 @@ MapTaintedValuesToCallee::computeTargets(ExtendedValue fact)
           ev.setMemLocationSeq(patchableMemLocationSeq);
         }
 
-        if (isVarArgParam) ev.setVarArgIndex(varArgIndex);
+        if (isVarArgParam) ev.setVarArgIndex(sanitizedArg.varArgIndex);
 
         targetParamFacts.insert(ev);
 
@@ -76,11 +105,11 @@ MapTaintedValuesToCallee::computeTargets(ExtendedValue fact)
     else {
       bool genFact = DataFlowUtils::isValueTainted(arg, fact);
       if (genFact) {
-        std::vector<const llvm::Value*> patchablePart{ param };
+        const llvm::ArrayRef<const llvm::Value*> patchablePart(param);
 
         ExtendedValue ev(fact);
         ev.setMemLocationSeq(patchablePart);
-        if (isVarArgParam) ev.setVarArgIndex(varArgIndex);
+        if (isVarArgParam) ev.setVarArgIndex(sanitizedArg.varArgIndex);
 
         targetParamFacts.insert(ev);
 
@@ -91,13 +120,13 @@ MapTaintedValuesToCallee::computeTargets(ExtendedValue fact)
         DataFlowUtils::dumpFact(ev);
       }
     }
-
-    if (isVarArgParam) ++varArgIndex;
   }
 
   bool addLineNumber = !targetParamFacts.empty();
   if (addLineNumber) traceStats.add(callInst);
 
+  DataFlowUtils::compressVarArgFacts(targetParamFacts);
+
   std::set<ExtendedValue> targetFacts;
   std::set_union(targetGlobalFacts.begin(), targetGlobalFacts.end(),
                  targetParamFacts.begin(), targetParamFacts.end(),
@@ -7,6 +7,8 @@
 
 #include "../Stats/TraceStats.h"
 
+#include "../Utils/GlobalModRefTable.h"
+
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/CallSite.h>
 
@@ -22,10 +24,12 @@ class MapTaintedValuesToCallee :
 public:
   MapTaintedValuesToCallee(const llvm::CallInst* _callInst,
                            const llvm::Function* _destMthd,
+                           const GlobalModRefTable& _globalModRefTable,
                            TraceStats& _traceStats,
                            ExtendedValue _zeroValue) :
     callInst(_callInst),
     destMthd(_destMthd),
+    globalModRefTable(_globalModRefTable),
     traceStats(_traceStats),
     zeroValue(_zeroValue) { }
   ~MapTaintedValuesToCallee() override = default;
@@ -35,6 +39,7 @@ public:
 private:
   const llvm::CallInst* callInst;
   const llvm::Function* destMthd;
+  const GlobalModRefTable& globalModRefTable;
   TraceStats& traceStats;
   ExtendedValue zeroValue;
 };
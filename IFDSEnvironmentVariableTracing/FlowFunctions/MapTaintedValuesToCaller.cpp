@@ -25,21 +25,21 @@ MapTaintedValuesToCaller::computeTargets(ExtendedValue fact)
   const auto retValMemLocationMatr = retInst->getReturnValue();
   if (!retValMemLocationMatr) return targetGlobalFacts;
 
-  auto retValMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(retValMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> retValMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(retValMemLocationMatr);
 
   bool isRetValMemLocation = !retValMemLocationSeq.empty();
   if (isRetValMemLocation) {
     const auto factMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromFact(fact);
 
     bool isArrayDecay = DataFlowUtils::isArrayDecay(retValMemLocationMatr);
-    if (isArrayDecay) retValMemLocationSeq.pop_back();
+    if (isArrayDecay) retValMemLocationSeq = retValMemLocationSeq.drop_back();
 
     bool genFact = DataFlowUtils::isSubsetMemoryLocationSeq(retValMemLocationSeq,
                                                             factMemLocationSeq);
     if (genFact) {
       const auto relocatableMemLocationSeq = DataFlowUtils::getRelocatableMemoryLocationSeq(factMemLocationSeq,
                                                                                             retValMemLocationSeq);
-      std::vector<const llvm::Value*> patchablePart{ callInst };
+      const llvm::ArrayRef<const llvm::Value*> patchablePart(callInst);
       const auto patchableMemLocationSeq = DataFlowUtils::joinMemoryLocationSeqs(patchablePart,
                                                                                  relocatableMemLocationSeq);
 
@@ -64,7 +64,7 @@ MapTaintedValuesToCaller::computeTargets(ExtendedValue fact)
   else {
     bool genFact = DataFlowUtils::isValueTainted(retValMemLocationMatr, fact);
     if (genFact) {
-      std::vector<const llvm::Value*> patchablePart{ callInst };
+      const llvm::ArrayRef<const llvm::Value*> patchablePart(callInst);
 
       ExtendedValue ev(callInst);
       ev.setMemLocationSeq(patchablePart);
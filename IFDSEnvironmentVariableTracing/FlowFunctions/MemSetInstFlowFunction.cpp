@@ -14,7 +14,7 @@ MemSetInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   const auto memSetInst = llvm::cast<const llvm::MemSetInst>(currentInst);
   const auto dstMemLocationMatr = memSetInst->getRawDest();
 
-  bool killFact = DataFlowUtils::isMemoryLocationTainted(dstMemLocationMatr, fact);
+  bool killFact = DataFlowUtils::isMemoryLocationKilled(dstMemLocationMatr, fact);
   if (killFact) {
     traceStats.add(memSetInst);
 
@@ -24,4 +24,6 @@ MemSetInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<MemSetInstFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class MemSetInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<MemSetInstFlowFunction>
 {
 public:
   MemSetInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~MemSetInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<MemSetInstFlowFunction>;
+
 } // namespace
 
 #endif // MEMSETINSTFLOWFUNCTION_H
@@ -17,8 +17,8 @@ MemTransferInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   const auto dstMemLocationMatr = memTransferInst->getRawDest();
 
   const auto factMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromFact(fact);
-  auto srcMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(srcMemLocationMatr);
-  auto dstMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(dstMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(srcMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> dstMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(dstMemLocationMatr);
 
   bool isArgumentPatch = DataFlowUtils::isPatchableArgumentMemcpy(memTransferInst->getRawSource(),
                                                                   srcMemLocationSeq,
@@ -38,6 +38,9 @@ MemTransferInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
     targetFacts.insert(ev);
     traceStats.add(memTransferInst, dstMemLocationSeq);
 
+    const auto remainingVarArgFacts = DataFlowUtils::getRemainingVarArgFacts(fact);
+    targetFacts.insert(remainingVarArgFacts.begin(), remainingVarArgFacts.end());
+
     LOG_DEBUG("Patched memory location (arg/memcpy)");
     LOG_DEBUG("Source");
     DataFlowUtils::dumpFact(fact);
@@ -46,13 +49,13 @@ MemTransferInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   }
   else {
     bool isSrcArrayDecay = DataFlowUtils::isArrayDecay(srcMemLocationMatr);
-    if (isSrcArrayDecay) srcMemLocationSeq.pop_back();
+    if (isSrcArrayDecay) srcMemLocationSeq = srcMemLocationSeq.drop_back();
 
     bool isDstArrayDecay = DataFlowUtils::isArrayDecay(dstMemLocationMatr);
-    if (isDstArrayDecay) dstMemLocationSeq.pop_back();
+    if (isDstArrayDecay) dstMemLocationSeq = dstMemLocationSeq.drop_back();
 
     bool genFact = DataFlowUtils::isSubsetMemoryLocationSeq(srcMemLocationSeq, factMemLocationSeq);
-    bool killFact = DataFlowUtils::isSubsetMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq);
+    bool killFact = DataFlowUtils::isKilledMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq);
 
     if (genFact) {
       const auto relocatableMemLocationSeq = DataFlowUtils::getRelocatableMemoryLocationSeq(factMemLocationSeq,
@@ -77,4 +80,6 @@ MemTransferInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return targetFacts;
 }
 
+template class FlowFunctionBase<MemTransferInstFlowFunction>;
+
 } // namespace
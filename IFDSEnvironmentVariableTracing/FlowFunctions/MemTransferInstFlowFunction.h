@@ -10,7 +10,7 @@
 namespace psr {
 
 class MemTransferInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<MemTransferInstFlowFunction>
 {
 public:
   MemTransferInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~MemTransferInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<MemTransferInstFlowFunction>;
+
 } // namespace
 
 #endif // MEMTRANSFERINSTFLOWFUNCTION_H
@@ -0,0 +1,104 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "MemoizingFlowFunction.h"
+
+#include "../Utils/Log.h"
+
+namespace psr {
+
+FactId
+ComputeTargetsMemo::intern(const ExtendedValue& fact)
+{
+  bool isGenerationFull = factTable.size() >= capacity * MAX_FACTS_PER_ENTRY;
+  if (isGenerationFull) {
+    evictions += entries.size();
+
+    entries.clear();
+    lruList.clear();
+    factTable.clear();
+
+    ++generations;
+  }
+
+  return factTable.intern(fact);
+}
+
+bool
+ComputeTargetsMemo::find(const Key& key,
+                         std::set<ExtendedValue>& targetFacts)
+{
+  const auto entry = entries.find(key);
+  if (entry == entries.end()) {
+    ++misses;
+
+    return false;
+  }
+
+  ++hits;
+
+  // Mark as most recently used
+  lruList.splice(lruList.begin(), lruList, entry->second.second);
+
+  for (const auto targetFactId : entry->second.first) {
+    targetFacts.insert(factTable.getFact(targetFactId));
+  }
+
+  return true;
+}
+
+void
+ComputeTargetsMemo::insert(const Key& key,
+                           const std::set<ExtendedValue>& targetFacts)
+{
+  if (entries.find(key) != entries.end()) return;
+
+  while (entries.size() >= capacity && !lruList.empty()) {
+    entries.erase(lruList.back());
+    lruList.pop_back();
+
+    ++evictions;
+  }
+
+  std::vector<FactId> targetFactIds;
+  targetFactIds.reserve(targetFacts.size());
+
+  for (const auto& targetFact : targetFacts) {
+    targetFactIds.push_back(factTable.intern(targetFact));
+  }
+
+  lruList.push_front(key);
+  entries.insert({ key, { targetFactIds, lruList.begin() } });
+}
+
+void
+ComputeTargetsMemo::logStats() const
+{
+  LOG_INFO("computeTargets memo: " << hits << " hits, "
+                                   << misses << " misses, "
+                                   << evictions << " evictions, "
+                                   << entries.size() << "/" << capacity << " entries");
+  LOG_INFO("Interned facts: " << factTable.size() << " ("
+                              << factTable.getNumSeqs() << " sequences, "
+                              << factTable.getNumColdFacts() << " cold fields), "
+                              << generations << " generations dropped");
+}
+
+std::set<ExtendedValue>
+MemoizingFlowFunction::computeTargets(ExtendedValue fact)
+{
+  const ComputeTargetsMemo::Key key(flowFunction.get(), memo.intern(fact));
+
+  std::set<ExtendedValue> memoizedTargetFacts;
+
+  bool isMemoized = memo.find(key, memoizedTargetFacts);
+  if (isMemoized) return memoizedTargetFacts;
+
+  const auto targetFacts = flowFunction->computeTargets(fact);
+  memo.insert(key, targetFacts);
+
+  return targetFacts;
+}
+
+} // namespace
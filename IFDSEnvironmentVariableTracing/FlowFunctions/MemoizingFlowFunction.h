@@ -0,0 +1,110 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef MEMOIZINGFLOWFUNCTION_H
+#define MEMOIZINGFLOWFUNCTION_H
+
+#include "../Utils/FactTable.h"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <phasar/PhasarLLVM/Domain/ExtendedValue.h>
+#include <phasar/PhasarLLVM/IfdsIde/FlowFunction.h>
+
+namespace psr {
+
+/*
+ * Results of computeTargets() per (flow function, fact). Flow functions are
+ * pure apart from adding line numbers to the trace stats which is idempotent
+ * so we do not need to replay anything on a hit. The number of entries is
+ * limited, the least recently used entry is evicted first.
+ *
+ * Facts are interned so keys and results are plain handles. Interned facts
+ * live as long as the memo generation they were interned in: once the fact
+ * table has grown past MAX_FACTS_PER_ENTRY facts per entry of capacity all
+ * entries and the fact table are dropped together (see intern()). Memory is
+ * thus bounded by the capacity.
+ */
+class ComputeTargetsMemo
+{
+public:
+  using Key = std::pair<const FlowFunction<ExtendedValue>*, FactId>;
+
+  ComputeTargetsMemo(std::size_t _capacity) :
+    capacity(_capacity) { }
+  ~ComputeTargetsMemo() = default;
+
+  bool isEnabled() const
+  {
+    return capacity > 0;
+  }
+
+  /*
+   * Handles are valid until the next call to intern() so keys must be
+   * interned right before they are looked up.
+   */
+  FactId intern(const ExtendedValue& fact);
+
+  bool find(const Key& key,
+            std::set<ExtendedValue>& targetFacts);
+  void insert(const Key& key,
+              const std::set<ExtendedValue>& targetFacts);
+
+  void logStats() const;
+
+private:
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const
+    {
+      return std::hash<const FlowFunction<ExtendedValue>*>{}(key.first) ^
+             (std::hash<FactId>{}(key.second) << 1);
+    }
+  };
+
+  using LRUList = std::list<Key>;
+
+  static const std::size_t MAX_FACTS_PER_ENTRY = 4;
+
+  std::size_t capacity;
+
+  FactTable factTable;
+
+  LRUList lruList;
+  std::unordered_map<Key, std::pair<std::vector<FactId>, LRUList::iterator>, KeyHash> entries;
+
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+  unsigned long evictions = 0;
+  unsigned long generations = 0;
+};
+
+class MemoizingFlowFunction :
+    public FlowFunction<ExtendedValue>
+{
+public:
+  MemoizingFlowFunction(std::shared_ptr<FlowFunction<ExtendedValue>> _flowFunction,
+                        ComputeTargetsMemo& _memo) :
+    flowFunction(_flowFunction),
+    memo(_memo) { }
+  ~MemoizingFlowFunction() override = default;
+
+  std::set<ExtendedValue>
+  computeTargets(ExtendedValue fact) override;
+
+private:
+  std::shared_ptr<FlowFunction<ExtendedValue>> flowFunction;
+  ComputeTargetsMemo& memo;
+};
+
+} // namespace
+
+#endif // MEMOIZINGFLOWFUNCTION_H
@@ -27,4 +27,6 @@ PHINodeFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<PHINodeFlowFunction>;
+
 } // namespace
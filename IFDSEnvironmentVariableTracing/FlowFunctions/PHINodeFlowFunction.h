@@ -10,7 +10,7 @@
 namespace psr {
 
 class PHINodeFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<PHINodeFlowFunction>
 {
 public:
   PHINodeFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~PHINodeFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<PHINodeFlowFunction>;
+
 } // namespace
 
 #endif // PHINODELOWFUNCTION_H
@@ -28,4 +28,6 @@ ReturnInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<ReturnInstFlowFunction>;
+
 } // namespace
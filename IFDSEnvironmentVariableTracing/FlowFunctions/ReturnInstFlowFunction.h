@@ -10,7 +10,7 @@
 namespace psr {
 
 class ReturnInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<ReturnInstFlowFunction>
 {
 public:
   ReturnInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~ReturnInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<ReturnInstFlowFunction>;
+
 } // namespace
 
 #endif // RETURNINSTFLOWFUNCTION_H
@@ -15,8 +15,8 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   const auto dstMemLocationMatr = storeInst->getPointerOperand();
 
   const auto factMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromFact(fact);
-  auto srcMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(srcMemLocationMatr);
-  auto dstMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(dstMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(srcMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> dstMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(dstMemLocationMatr);
 
   bool isArgumentPatch = DataFlowUtils::isPatchableArgumentStore(srcMemLocationMatr, fact);
   bool isVaListArgumentPatch = DataFlowUtils::isPatchableVaListArgument(srcMemLocationMatr, fact);
@@ -43,7 +43,7 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
       bool isArgCoerced = srcMemLocationMatr->getName().contains_lower("coerce");
       if (isArgCoerced) {
         assert(dstMemLocationSeq.size() > 1);
-        dstMemLocationSeq.pop_back();
+        dstMemLocationSeq = dstMemLocationSeq.drop_back();
       }
 
       const auto patchableMemLocationSeq = isVaListArgumentPatch ? DataFlowUtils::getVaListMemoryLocationSeqFromFact(fact) :
@@ -65,6 +65,11 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
       targetFacts.insert(ev);
       traceStats.add(storeInst, dstMemLocationSeq);
 
+      if (!isVaListArgumentPatch) {
+        const auto remainingVarArgFacts = DataFlowUtils::getRemainingVarArgFacts(fact);
+        targetFacts.insert(remainingVarArgFacts.begin(), remainingVarArgFacts.end());
+      }
+
       LOG_DEBUG("Patched memory location (arg/store)");
       LOG_DEBUG("Source");
       DataFlowUtils::dumpFact(fact);
@@ -82,7 +87,7 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
       bool isExtractValue = llvm::isa<llvm::ExtractValueInst>(srcMemLocationMatr);
       if (isExtractValue) {
         assert(dstMemLocationSeq.size() > 1);
-        dstMemLocationSeq.pop_back();
+        dstMemLocationSeq = dstMemLocationSeq.drop_back();
       }
 
       const auto patchedMemLocationSeq = DataFlowUtils::patchMemoryLocationFrame(factMemLocationSeq,
@@ -111,10 +116,10 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   else
   if (isSrcMemLocation) {
     bool isArrayDecay = DataFlowUtils::isArrayDecay(srcMemLocationMatr);
-    if (isArrayDecay) srcMemLocationSeq.pop_back();
+    if (isArrayDecay) srcMemLocationSeq = srcMemLocationSeq.drop_back();
 
     bool genFact = DataFlowUtils::isSubsetMemoryLocationSeq(srcMemLocationSeq, factMemLocationSeq);
-    bool killFact = DataFlowUtils::isSubsetMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq) ||
+    bool killFact = DataFlowUtils::isKilledMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq) ||
                     DataFlowUtils::isKillAfterStoreFact(fact);
 
     if (genFact) {
@@ -139,7 +144,7 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   }
   else {
     bool genFact = DataFlowUtils::isValueTainted(srcMemLocationMatr, fact);
-    bool killFact = DataFlowUtils::isSubsetMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq) ||
+    bool killFact = DataFlowUtils::isKilledMemoryLocationSeq(dstMemLocationSeq, factMemLocationSeq) ||
                     DataFlowUtils::isKillAfterStoreFact(fact);
 
     if (genFact) {
@@ -155,4 +160,6 @@ StoreInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return targetFacts;
 }
 
+template class FlowFunctionBase<StoreInstFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class StoreInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<StoreInstFlowFunction>
 {
 public:
   StoreInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~StoreInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<StoreInstFlowFunction>;
+
 } // namespace
 
 #endif // STOREINSTFLOWFUNCTION_H
@@ -17,12 +17,12 @@ VAEndInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   const auto vaEndInst = llvm::cast<llvm::VAEndInst>(currentInst);
   const auto vaEndMemLocationMatr = vaEndInst->getArgList();
 
-  auto vaEndMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(vaEndMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> vaEndMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(vaEndMemLocationMatr);
 
   bool isValidMemLocationSeq = !vaEndMemLocationSeq.empty();
   if (isValidMemLocationSeq) {
     bool isArrayDecay = DataFlowUtils::isArrayDecay(vaEndMemLocationMatr);
-    if (isArrayDecay) vaEndMemLocationSeq.pop_back();
+    if (isArrayDecay) vaEndMemLocationSeq = vaEndMemLocationSeq.drop_back();
 
     bool isVaListEqual = DataFlowUtils::isMemoryLocationSeqsEqual(DataFlowUtils::getVaListMemoryLocationSeqFromFact(fact),
                                                                   vaEndMemLocationSeq);
@@ -37,4 +37,6 @@ VAEndInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return { fact };
 }
 
+template class FlowFunctionBase<VAEndInstFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class VAEndInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<VAEndInstFlowFunction>
 {
 public:
   VAEndInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~VAEndInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<VAEndInstFlowFunction>;
+
 } // namespace
 
 #endif // VAENDINSTFLOWFUNCTION_H
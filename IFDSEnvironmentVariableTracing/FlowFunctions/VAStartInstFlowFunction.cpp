@@ -20,12 +20,12 @@ VAStartInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   const auto vaStartInst = llvm::cast<llvm::VAStartInst>(currentInst);
   const auto vaListMemLocationMatr = vaStartInst->getArgList();
 
-  auto vaListMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(vaListMemLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> vaListMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(vaListMemLocationMatr);
 
   bool isValidMemLocationSeq = !vaListMemLocationSeq.empty();
   if (isValidMemLocationSeq) {
     bool isArrayDecay = DataFlowUtils::isArrayDecay(vaListMemLocationMatr);
-    if (isArrayDecay) vaListMemLocationSeq.pop_back();
+    if (isArrayDecay) vaListMemLocationSeq = vaListMemLocationSeq.drop_back();
 
     ExtendedValue ev(fact);
     ev.setVaListMemLocationSeq(vaListMemLocationSeq);
@@ -42,4 +42,6 @@ VAStartInstFlowFunction::computeTargetsExt(ExtendedValue& fact)
   return targetFacts;
 }
 
+template class FlowFunctionBase<VAStartInstFlowFunction>;
+
 } // namespace
@@ -10,7 +10,7 @@
 namespace psr {
 
 class VAStartInstFlowFunction :
-    public FlowFunctionBase
+    public FlowFunctionBase<VAStartInstFlowFunction>
 {
 public:
   VAStartInstFlowFunction(const llvm::Instruction* _currentInst,
@@ -19,9 +19,11 @@ public:
     FlowFunctionBase(_currentInst, _traceStats, _zeroValue) { }
   ~VAStartInstFlowFunction() override = default;
 
-  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact) override;
+  std::set<ExtendedValue> computeTargetsExt(ExtendedValue& fact);
 };
 
+extern template class FlowFunctionBase<VAStartInstFlowFunction>;
+
 } // namespace
 
 #endif // VASTARTINSTFLOWFUNCTION_H
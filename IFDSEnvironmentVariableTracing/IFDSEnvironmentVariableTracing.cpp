@@ -24,18 +24,19 @@
 
 #include "FlowFunctions/IdentityFlowFunction.h"
 #include "FlowFunctions/GenerateFlowFunction.h"
+#include "FlowFunctions/ComposeFlowFunction.h"
 
 #include "FlowFunctions/MapTaintedValuesToCallee.h"
 #include "FlowFunctions/MapTaintedValuesToCaller.h"
 
 #include "Utils/DataFlowUtils.h"
+#include "Utils/Log.h"
 
+#include <queue>
 #include <set>
 #include <string>
 #include <vector>
 
-#include <llvm/IR/IntrinsicInst.h>
-
 #include <phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h>
 
 namespace psr {
@@ -58,45 +59,214 @@ IFDSEnvironmentVariableTracing::IFDSEnvironmentVariableTracing(LLVMBasedICFG& ic
                                                                std::vector<std::string> entryPoints) :
   IFDSTabulationProblemPluginExtendedValue(icfg, entryPoints),
   taintedFunctions(DataFlowUtils::getTaintedFunctions()),
-  blacklistedFunctions(DataFlowUtils::getBlacklistedFunctions())
+  blacklistedFunctions(DataFlowUtils::getBlacklistedFunctions()),
+  functionFlagsTable(taintedFunctions, blacklistedFunctions),
+  globalModRefTable(functionFlagsTable),
+  computeTargetsMemo(DataFlowUtils::getComputeTargetsMemoSize()),
+  normalFlowFunctionCache("Normal"),
+  callFlowFunctionCache("Call"),
+  retFlowFunctionCache("Return"),
+  callToRetFlowFunctionCache("Call to return"),
+  summaryFlowFunctionCache("Summary"),
+  identityFlowFunctionCache("Identity")
 {
   this->solver_config.computeValues = false;
   this->solver_config.computePersistedSummaries = false;
+
+  std::set<const llvm::Module*> modules;
+  std::vector<const llvm::Function*> entryPointFunctions;
+  for (const auto& entryPoint : entryPoints) {
+    const auto entryPointFunction = icfg.getMethod(entryPoint);
+    if (!entryPointFunction) continue;
+
+    modules.insert(entryPointFunction->getParent());
+    entryPointFunctions.push_back(entryPointFunction);
+  }
+
+  for (const auto module : modules) {
+    DataFlowUtils::classifyTypes(*module);
+    DataFlowUtils::numberValues(*module);
+    functionFlagsTable.classify(*module);
+  }
+
+  const auto reachableFunctions = getReachableFunctions(entryPointFunctions);
+
+  DataFlowUtils::precompute(reachableFunctions);
+  globalModRefTable.compute(reachableFunctions);
+
+  // Read (and log) tainted block mode, fact set reduction and sequence limits up front
+  DataFlowUtils::isCompactTaintedBlocks();
+  DataFlowUtils::isReduceFactSets();
+  DataFlowUtils::getMemoryLocationSeqLimit();
+  DataFlowUtils::getAdaptiveSeqLimitThreshold();
 }
 
+IFDSEnvironmentVariableTracing::~IFDSEnvironmentVariableTracing()
+{
+  DataFlowUtils::clearCaches();
+}
+
+/*
+ * The ret instruction is the exit of a function and never the current
+ * instruction of a normal edge. Hence on every edge into a ret we evaluate
+ * the current instruction and the ret instruction at once. A ret without an
+ * incoming edge (first instruction of a function) is evaluated when mapping
+ * facts to the callee (see getCallFlowFunction()).
+ */
 std::shared_ptr<FlowFunction<ExtendedValue>>
 IFDSEnvironmentVariableTracing::getNormalFlowFunction(const llvm::Instruction* currentInst,
                                                       const llvm::Instruction* successorInst)
 {
-  if (DataFlowUtils::isReturnValue(currentInst, successorInst))
-    return std::make_shared<ReturnInstFlowFunction>(successorInst, traceStats, zeroValue());
+  return normalFlowFunctionCache.get(std::make_pair(currentInst, successorInst), [&]() {
+    return createNormalFlowFunction(currentInst, successorInst);
+  });
+}
+
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::createNormalFlowFunction(const llvm::Instruction* currentInst,
+                                                         const llvm::Instruction* successorInst)
+{
+  const auto currentInstFlowFunction = getInstFlowFunction(currentInst);
+
+  bool isSuccessorRetInst = llvm::isa<llvm::ReturnInst>(successorInst);
+  if (isSuccessorRetInst)
+    return std::make_shared<ComposeFlowFunction>(currentInstFlowFunction,
+                                                 std::make_shared<ReturnInstFlowFunction>(successorInst, traceStats, zeroValue()));
+
+  return currentInstFlowFunction;
+}
+
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::getInstFlowFunction(const llvm::Instruction* currentInst)
+{
+  switch (DataFlowUtils::getFlowKind(currentInst)) {
+  case FlowKind::STORE:
+    return memoize(std::make_shared<StoreInstFlowFunction>(currentInst, traceStats, zeroValue()));
+  case FlowKind::BRANCH_SWITCH:
+    return memoize(std::make_shared<BranchSwitchInstFlowFunction>(currentInst, traceStats, zeroValue()));
+  case FlowKind::GEP:
+    return memoize(std::make_shared<GEPInstFlowFunction>(currentInst, traceStats, zeroValue()));
+  case FlowKind::PHI_NODE:
+    return memoize(std::make_shared<PHINodeFlowFunction>(currentInst, traceStats, zeroValue()));
+  case FlowKind::CHECK_OPERANDS:
+    return memoize(std::make_shared<CheckOperandsFlowFunction>(currentInst, traceStats, zeroValue()));
+  case FlowKind::IDENTITY:
+    break;
+  }
+
+  return getIdentityFlowFunction(currentInst);
+}
+
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::getIdentityFlowFunction(const llvm::Instruction* currentInst)
+{
+  return identityFlowFunctionCache.get(currentInst, [&]() {
+    return std::make_shared<IdentityFlowFunction>(currentInst, traceStats, zeroValue());
+  });
+}
+
+/*
+ * Functions whose bodies might be analyzed. Direct calls are followed, an
+ * indirect call might reach every function whose address has been taken.
+ * Declarations and blacklisted functions are never entered by the solver.
+ */
+const std::vector<const llvm::Function*>
+IFDSEnvironmentVariableTracing::getReachableFunctions(const std::vector<const llvm::Function*>& entryPointFunctions)
+{
+  std::vector<const llvm::Function*> reachableFunctions;
+  std::set<const llvm::Function*> visitedFunctions;
+  std::queue<const llvm::Function*> workList;
 
-  if (llvm::isa<llvm::StoreInst>(currentInst))
-    return std::make_shared<StoreInstFlowFunction>(currentInst, traceStats, zeroValue());
+  bool isAddressTakenFunctionsReachable = false;
 
-  if (llvm::isa<llvm::BranchInst>(currentInst) || llvm::isa<llvm::SwitchInst>(currentInst))
-    return std::make_shared<BranchSwitchInstFlowFunction>(currentInst, traceStats, zeroValue());
+  const auto enqueue = [&](const llvm::Function* function) {
+    bool isAnalyzedFunction = !functionFlagsTable.is(function, FunctionFlagsTable::DECLARATION |
+                                                               FunctionFlagsTable::BLACKLISTED);
+    if (!isAnalyzedFunction) return;
 
-  if (llvm::isa<llvm::GetElementPtrInst>(currentInst))
-    return std::make_shared<GEPInstFlowFunction>(currentInst, traceStats, zeroValue());
+    bool isNewFunction = visitedFunctions.insert(function).second;
+    if (isNewFunction) workList.push(function);
+  };
 
-  if (llvm::isa<llvm::PHINode>(currentInst))
-    return std::make_shared<PHINodeFlowFunction>(currentInst, traceStats, zeroValue());
+  for (const auto entryPointFunction : entryPointFunctions) {
+    enqueue(entryPointFunction);
+  }
+
+  while (!workList.empty()) {
+    const auto function = workList.front();
+    workList.pop();
+
+    reachableFunctions.push_back(function);
+
+    for (const auto& basicBlock : *function) {
+      for (const auto& instruction : basicBlock) {
+        const auto callInst = llvm::dyn_cast<llvm::CallInst>(&instruction);
+        if (!callInst) continue;
+
+        const auto calledFunction = callInst->getCalledFunction();
+        if (calledFunction) {
+          enqueue(calledFunction);
+          continue;
+        }
+
+        if (isAddressTakenFunctionsReachable) continue;
+        isAddressTakenFunctionsReachable = true;
+
+        for (const auto& addressTakenFunction : *function->getParent()) {
+          bool isAddressTaken = functionFlagsTable.is(&addressTakenFunction, FunctionFlagsTable::ADDRESS_TAKEN);
+          if (isAddressTaken) enqueue(&addressTakenFunction);
+        }
+      }
+    }
+  }
+
+  return reachableFunctions;
+}
 
-  if (DataFlowUtils::isCheckOperandsInst(currentInst))
-    return std::make_shared<CheckOperandsFlowFunction>(currentInst, traceStats, zeroValue());
+/*
+ * Only wrap flow functions that do real work on memory locations. Identity
+ * like flow functions are cheaper than a memo lookup.
+ */
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::memoize(std::shared_ptr<FlowFunction<ExtendedValue>> flowFunction)
+{
+  if (!computeTargetsMemo.isEnabled()) return flowFunction;
 
-  return std::make_shared<IdentityFlowFunction>(currentInst, traceStats, zeroValue());
+  return std::make_shared<MemoizingFlowFunction>(flowFunction, computeTargetsMemo);
 }
 
 std::shared_ptr<FlowFunction<ExtendedValue>>
 IFDSEnvironmentVariableTracing::getCallFlowFunction(const llvm::Instruction* callStmt,
                                                     const llvm::Function* destMthd)
 {
-  return std::make_shared<MapTaintedValuesToCallee>(llvm::cast<llvm::CallInst>(callStmt),
-                                                    destMthd,
-                                                    traceStats,
-                                                    zeroValue());
+  return callFlowFunctionCache.get(std::make_pair(callStmt, destMthd), [&]() {
+    return createCallFlowFunction(callStmt, destMthd);
+  });
+}
+
+/*
+ * Facts are mapped to the first instruction of the callee. If that is a ret
+ * there is no edge into it so we evaluate it right here. Entry points start
+ * with the zero value only which never taints a return value.
+ */
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::createCallFlowFunction(const llvm::Instruction* callStmt,
+                                                       const llvm::Function* destMthd)
+{
+  const auto mapToCalleeFlowFunction = memoize(std::make_shared<MapTaintedValuesToCallee>(llvm::cast<llvm::CallInst>(callStmt),
+                                                                                          destMthd,
+                                                                                          globalModRefTable,
+                                                                                          traceStats,
+                                                                                          zeroValue()));
+
+  const auto firstInst = &destMthd->front().front();
+
+  bool isFirstInstRetInst = llvm::isa<llvm::ReturnInst>(firstInst);
+  if (isFirstInstRetInst)
+    return std::make_shared<ComposeFlowFunction>(mapToCalleeFlowFunction,
+                                                 std::make_shared<ReturnInstFlowFunction>(firstInst, traceStats, zeroValue()));
+
+  return mapToCalleeFlowFunction;
 }
 
 std::shared_ptr<FlowFunction<ExtendedValue>>
@@ -105,10 +275,12 @@ IFDSEnvironmentVariableTracing::getRetFlowFunction(const llvm::Instruction* call
                                                    const llvm::Instruction* exitStmt,
                                                    const llvm::Instruction* retSite)
 {
-  return std::make_shared<MapTaintedValuesToCaller>(llvm::cast<llvm::CallInst>(callSite),
-                                                    llvm::cast<llvm::ReturnInst>(exitStmt),
-                                                    traceStats,
-                                                    zeroValue());
+  return retFlowFunctionCache.get(std::make_tuple(callSite, exitStmt, retSite), [&]() {
+    return memoize(std::make_shared<MapTaintedValuesToCaller>(llvm::cast<llvm::CallInst>(callSite),
+                                                              llvm::cast<llvm::ReturnInst>(exitStmt),
+                                                              traceStats,
+                                                              zeroValue()));
+  });
 }
 
 /*
@@ -138,7 +310,22 @@ IFDSEnvironmentVariableTracing::getCallToRetFlowFunction(const llvm::Instruction
    * the function. If we intercept here the call instruction will be pushed when the flow
    * function is called with the branch instruction fact.
    */
-  return std::make_shared<CallToRetFlowFunction>(callSite, traceStats, zeroValue());
+  return callToRetFlowFunctionCache.get(std::make_pair(callSite, retSite), [&]() {
+    const auto calledFunction = llvm::cast<llvm::CallInst>(callSite)->getCalledFunction();
+
+    bool isHandledInSummaryFlowFunction = calledFunction &&
+                                          functionFlagsTable.is(calledFunction,
+                                                                FunctionFlagsTable::MEM_TRANSFER |
+                                                                FunctionFlagsTable::MEM_SET |
+                                                                FunctionFlagsTable::VA_END);
+
+    return std::make_shared<CallToRetFlowFunction>(callSite,
+                                                   isHandledInSummaryFlowFunction,
+                                                   callees,
+                                                   globalModRefTable,
+                                                   traceStats,
+                                                   zeroValue());
+  });
 }
 
 /*
@@ -149,8 +336,15 @@ std::shared_ptr<FlowFunction<ExtendedValue>>
 IFDSEnvironmentVariableTracing::getSummaryFlowFunction(const llvm::Instruction* callStmt,
                                                        const llvm::Function* destMthd)
 {
-  const auto destMthdName = destMthd->getName();
+  return summaryFlowFunctionCache.get(std::make_pair(callStmt, destMthd), [&]() {
+    return createSummaryFlowFunction(callStmt, destMthd);
+  });
+}
 
+std::shared_ptr<FlowFunction<ExtendedValue>>
+IFDSEnvironmentVariableTracing::createSummaryFlowFunction(const llvm::Instruction* callStmt,
+                                                          const llvm::Function* destMthd)
+{
   /*
    * We exclude function ptr calls as they will be applied to every
    * function matching its signature (@see LLVMBasedICFG.cpp:217).
@@ -158,43 +352,45 @@ IFDSEnvironmentVariableTracing::getSummaryFlowFunction(const llvm::Instruction*
   const auto callInst = llvm::cast<llvm::CallInst>(callStmt);
   bool isStaticCallSite = callInst->getCalledFunction();
   if (!isStaticCallSite)
-    return std::make_shared<IdentityFlowFunction>(callStmt, traceStats, zeroValue());
+    return getIdentityFlowFunction(callStmt);
+
+  const auto destMthdFlags = functionFlagsTable.getFlags(destMthd);
 
   /*
    * Exclude blacklisted functions here.
    */
-  bool isBlacklistedFunction = blacklistedFunctions.find(destMthdName) != blacklistedFunctions.end();
+  bool isBlacklistedFunction = destMthdFlags & FunctionFlagsTable::BLACKLISTED;
   if (isBlacklistedFunction)
-    return std::make_shared<IdentityFlowFunction>(callStmt, traceStats, zeroValue());
+    return getIdentityFlowFunction(callStmt);
 
   /*
    * Intrinsics.
    */
-  if (llvm::isa<llvm::MemTransferInst>(callStmt))
-    return std::make_shared<MemTransferInstFlowFunction>(callStmt, traceStats, zeroValue());
+  if (destMthdFlags & FunctionFlagsTable::MEM_TRANSFER)
+    return memoize(std::make_shared<MemTransferInstFlowFunction>(callStmt, traceStats, zeroValue()));
 
-  if (llvm::isa<llvm::MemSetInst>(callStmt))
-    return std::make_shared<MemSetInstFlowFunction>(callStmt, traceStats, zeroValue());
+  if (destMthdFlags & FunctionFlagsTable::MEM_SET)
+    return memoize(std::make_shared<MemSetInstFlowFunction>(callStmt, traceStats, zeroValue()));
 
-  if (llvm::isa<llvm::VAStartInst>(callStmt))
-    return std::make_shared<VAStartInstFlowFunction>(callStmt, traceStats, zeroValue());
+  if (destMthdFlags & FunctionFlagsTable::VA_START)
+    return memoize(std::make_shared<VAStartInstFlowFunction>(callStmt, traceStats, zeroValue()));
 
-  if (llvm::isa<llvm::VAEndInst>(callStmt))
-    return std::make_shared<VAEndInstFlowFunction>(callStmt, traceStats, zeroValue());
+  if (destMthdFlags & FunctionFlagsTable::VA_END)
+    return memoize(std::make_shared<VAEndInstFlowFunction>(callStmt, traceStats, zeroValue()));
 
   /*
    * Provide summary for tainted functions.
    */
-  bool isTaintedFunction = taintedFunctions.find(destMthdName) != taintedFunctions.end();
+  bool isTaintedFunction = destMthdFlags & FunctionFlagsTable::TAINTED;
   if (isTaintedFunction)
     return std::make_shared<GenerateFlowFunction>(callStmt, traceStats, zeroValue());
 
   /*
    * Skip all (other) declarations.
    */
-  bool isDeclaration = destMthd->isDeclaration();
+  bool isDeclaration = destMthdFlags & FunctionFlagsTable::DECLARATION;
   if (isDeclaration)
-    return std::make_shared<IdentityFlowFunction>(callStmt, traceStats, zeroValue());
+    return getIdentityFlowFunction(callStmt);
 
   /*
    * Follow call -> getCallFlowFunction()
@@ -208,10 +404,13 @@ IFDSEnvironmentVariableTracing::initialSeeds()
   std::map<const llvm::Instruction*, std::set<ExtendedValue>> seedMap;
 
   for (const auto& entryPoint : this->EntryPoints) {
-    bool isBlacklistedFunction = blacklistedFunctions.find(entryPoint) != blacklistedFunctions.end();
+    const auto entryPointFunction = icfg.getMethod(entryPoint);
+    if (!entryPointFunction) continue;
+
+    bool isBlacklistedFunction = functionFlagsTable.is(entryPointFunction, FunctionFlagsTable::BLACKLISTED);
     if (isBlacklistedFunction) continue;
 
-    seedMap.insert(std::make_pair(&icfg.getMethod(entryPoint)->front().front(),
+    seedMap.insert(std::make_pair(&entryPointFunction->front().front(),
                                   std::set<ExtendedValue>({ zeroValue() })));
   }
 
@@ -222,6 +421,11 @@ void
 IFDSEnvironmentVariableTracing::printIFDSReport(std::ostream& os,
                                                 SolverResults<const llvm::Instruction*, ExtendedValue, BinaryDomain>& solverResults)
 {
+  if (DataFlowUtils::isCompactTaintedBlocks()) {
+    long numInstructions = traceStats.expandTaintedBlocks();
+    LOG_INFO("Added " << numInstructions << " instructions of tainted blocks");
+  }
+
   const std::string lcovTraceFile = DataFlowUtils::getTraceFilenamePrefix(EntryPoints.front()) + "-trace.txt";
   const std::string lcovRetValTraceFile = DataFlowUtils::getTraceFilenamePrefix(EntryPoints.front()) + "-return-value-trace.txt";
 
@@ -238,6 +442,21 @@ IFDSEnvironmentVariableTracing::printIFDSReport(std::ostream& os,
   // Write lcov return value trace
   LcovRetValWriter lcovRetValWriter(traceStats, lcovRetValTraceFile);
   lcovRetValWriter.write();
+
+  DataFlowUtils::logCacheStats();
+
+  normalFlowFunctionCache.logStats();
+  callFlowFunctionCache.logStats();
+  retFlowFunctionCache.logStats();
+  callToRetFlowFunctionCache.logStats();
+  summaryFlowFunctionCache.logStats();
+  identityFlowFunctionCache.logStats();
+
+  LOG_INFO("Classified functions: " << functionFlagsTable.size());
+  LOG_INFO("Global mod/ref summaries: " << globalModRefTable.size() << " functions, "
+           << globalModRefTable.getNumGlobals() << " globals");
+
+  if (computeTargetsMemo.isEnabled()) computeTargetsMemo.logStats();
 }
 
 } // namespace
@@ -5,8 +5,17 @@
 #ifndef IFDSENVIRONMENTVARIABLETRACING_H
 #define IFDSENVIRONMENTVARIABLETRACING_H
 
+#include "FlowFunctions/FlowFunctionCache.h"
+#include "FlowFunctions/MemoizingFlowFunction.h"
+
 #include "Stats/TraceStats.h"
 
+#include "Utils/FunctionFlagsTable.h"
+#include "Utils/GlobalModRefTable.h"
+
+#include <tuple>
+#include <utility>
+
 #include <phasar/PhasarLLVM/Plugins/Interfaces/IfdsIde/IFDSTabulationProblemPluginExtendedValue.h>
 
 namespace psr {
@@ -17,7 +26,7 @@ class IFDSEnvironmentVariableTracing :
 public:
   IFDSEnvironmentVariableTracing(LLVMBasedICFG& icfg,
                                  std::vector<std::string> entryPoints);
-  ~IFDSEnvironmentVariableTracing() override = default;
+  ~IFDSEnvironmentVariableTracing() override;
 
   std::shared_ptr<FlowFunction<ExtendedValue>>
   getNormalFlowFunction(const llvm::Instruction* curr,
@@ -50,10 +59,46 @@ public:
                   SolverResults<const llvm::Instruction*, ExtendedValue, BinaryDomain>& solverResults) override;
 
 private:
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  getInstFlowFunction(const llvm::Instruction* currentInst);
+
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  getIdentityFlowFunction(const llvm::Instruction* currentInst);
+
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  memoize(std::shared_ptr<FlowFunction<ExtendedValue>> flowFunction);
+
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  createNormalFlowFunction(const llvm::Instruction* currentInst,
+                           const llvm::Instruction* successorInst);
+
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  createSummaryFlowFunction(const llvm::Instruction* callStmt,
+                            const llvm::Function* destMthd);
+
+  std::shared_ptr<FlowFunction<ExtendedValue>>
+  createCallFlowFunction(const llvm::Instruction* callStmt,
+                         const llvm::Function* destMthd);
+
+  const std::vector<const llvm::Function*>
+  getReachableFunctions(const std::vector<const llvm::Function*>& entryPointFunctions);
+
   const std::set<std::string> taintedFunctions;
   const std::set<std::string> blacklistedFunctions;
 
+  FunctionFlagsTable functionFlagsTable;
+  GlobalModRefTable globalModRefTable;
+
   TraceStats traceStats;
+
+  ComputeTargetsMemo computeTargetsMemo;
+
+  FlowFunctionCache<std::pair<const llvm::Instruction*, const llvm::Instruction*>> normalFlowFunctionCache;
+  FlowFunctionCache<std::pair<const llvm::Instruction*, const llvm::Function*>> callFlowFunctionCache;
+  FlowFunctionCache<std::tuple<const llvm::Instruction*, const llvm::Instruction*, const llvm::Instruction*>> retFlowFunctionCache;
+  FlowFunctionCache<std::pair<const llvm::Instruction*, const llvm::Instruction*>> callToRetFlowFunctionCache;
+  FlowFunctionCache<std::pair<const llvm::Instruction*, const llvm::Function*>> summaryFlowFunctionCache;
+  FlowFunctionCache<const llvm::Instruction*> identityFlowFunctionCache;
 };
 
 } // namespace
@@ -4,37 +4,26 @@
 
 #include "TraceStats.h"
 
+#include "../Utils/DataFlowUtils.h"
 #include "../Utils/Log.h"
 
+#include <queue>
+
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instructions.h>
 
-#include <llvm/IR/DebugInfoMetadata.h>
-
 namespace psr {
 
 long
 TraceStats::add(const llvm::Instruction* instruction,
                 bool isReturnValue)
 {
-  const llvm::DebugLoc debugLocInst = instruction->getDebugLoc();
-  if (!debugLocInst) return 0;
-
-  const llvm::DebugLoc debugLocFn = debugLocInst.getFnDebugLoc();
-  if (!debugLocFn) return 0;
-
-  const auto function = instruction->getFunction();
-  if (!function) return 0;
-
-  const auto functionName = function->getName();
-
-  const auto fnScope = llvm::cast<llvm::DIScope>(debugLocFn.getScope());
-
-  const std::string file = fnScope->getDirectory().str() +
-                           "/" +
-                           fnScope->getFilename().str();
+  const auto& debugLocation = DataFlowUtils::getDebugLocation(instruction);
+  if (!debugLocation.isValid) return 0;
 
-  unsigned int lineNumber = debugLocInst->getLine();
+  const auto& file = debugLocation.file;
+  const auto& functionName = debugLocation.functionName;
+  unsigned int lineNumber = debugLocation.lineNumber;
 
   LOG_DEBUG("Tainting " << file << ":" << functionName << ":" << lineNumber << ":" << isReturnValue);
 
@@ -54,7 +43,7 @@ TraceStats::add(const llvm::Instruction* instruction,
 
 long
 TraceStats::add(const llvm::Instruction* instruction,
-                const std::vector<const llvm::Value*> memLocationSeq)
+                llvm::ArrayRef<const llvm::Value*> memLocationSeq)
 {
   bool isRetInstruction = llvm::isa<llvm::ReturnInst>(instruction);
   if (isRetInstruction) {
@@ -82,6 +71,73 @@ TraceStats::add(const llvm::Instruction* instruction,
   return add(instruction, false);
 }
 
+/*
+ * Tainted blocks are recorded in compact tainted block mode only. The line
+ * numbers of their instructions are added in expandTaintedBlocks().
+ */
+void
+TraceStats::addTaintedBlock(const llvm::BasicBlock* startBasicBlock,
+                            const llvm::BasicBlock* endBasicBlock)
+{
+  taintedBlocks.insert({ startBasicBlock, endBasicBlock });
+}
+
+/*
+ * Add every instruction that would have been auto GENed: everything that is
+ * reachable from the tainted branch without passing the end of the tainted
+ * block plus the phi nodes of the end block.
+ */
+long
+TraceStats::expandTaintedBlocks()
+{
+  long numInstructions = 0;
+
+  for (const auto& taintedBlock : taintedBlocks) {
+    const auto startBasicBlock = taintedBlock.first;
+    const auto endBasicBlock = taintedBlock.second;
+
+    std::set<const llvm::BasicBlock*> visitedBasicBlocks;
+    std::queue<const llvm::BasicBlock*> workList;
+
+    const auto terminatorInst = startBasicBlock->getTerminator();
+    for (unsigned int i = 0; i < terminatorInst->getNumSuccessors(); ++i) {
+      workList.push(terminatorInst->getSuccessor(i));
+    }
+
+    while (!workList.empty()) {
+      const auto basicBlock = workList.front();
+      workList.pop();
+
+      bool isVisited = !visitedBasicBlocks.insert(basicBlock).second;
+      if (isVisited) continue;
+
+      if (basicBlock == endBasicBlock) {
+        for (const auto& instruction : *basicBlock) {
+          bool isPhiNode = llvm::isa<llvm::PHINode>(instruction);
+          if (!isPhiNode) break;
+
+          numInstructions += add(&instruction, false);
+        }
+        continue;
+      }
+
+      for (const auto& instruction : *basicBlock) {
+        bool isAutoGEN = DataFlowUtils::isAutoGENInTaintedBlock(&instruction);
+        if (isAutoGEN) numInstructions += add(&instruction, false);
+      }
+
+      const auto basicBlockTerminatorInst = basicBlock->getTerminator();
+      for (unsigned int i = 0; i < basicBlockTerminatorInst->getNumSuccessors(); ++i) {
+        workList.push(basicBlockTerminatorInst->getSuccessor(i));
+      }
+    }
+  }
+
+  taintedBlocks.clear();
+
+  return numInstructions;
+}
+
 TraceStats::FunctionStats&
 TraceStats::getFunctionStats(std::string file)
 {
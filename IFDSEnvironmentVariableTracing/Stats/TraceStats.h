@@ -9,7 +9,11 @@
 
 #include <map>
 #include <set>
+#include <utility>
 
+#include <llvm/ADT/ArrayRef.h>
+
+#include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Instruction.h>
 
 namespace psr {
@@ -25,7 +29,11 @@ public:
   ~TraceStats() = default;
 
   long add(const llvm::Instruction* instruction,
-           const std::vector<const llvm::Value*> memLocationSeq = std::vector<const llvm::Value*>());
+           llvm::ArrayRef<const llvm::Value*> memLocationSeq = llvm::ArrayRef<const llvm::Value*>());
+
+  void addTaintedBlock(const llvm::BasicBlock* startBasicBlock,
+                       const llvm::BasicBlock* endBasicBlock);
+  long expandTaintedBlocks();
 
   const FileStats getStats() const
   {
@@ -40,6 +48,8 @@ private:
   LineNumberStats& getLineNumberStats(std::string file,
                                       std::string function);
   FileStats stats;
+
+  std::set<std::pair<const llvm::BasicBlock*, const llvm::BasicBlock*>> taintedBlocks;
 };
 
 } // namespace
@@ -4,7 +4,12 @@
 
 #include "DataFlowUtils.h"
 
+#include "DetachedInstructionTable.h"
 #include "Log.h"
+#include "MemoryLocationSeqTrie.h"
+#include "SideTable.h"
+#include "TypeClassificationTable.h"
+#include "ValueNumbering.h"
 
 #include <algorithm>
 #include <cassert>
@@ -12,15 +17,24 @@
 #include <ctime>
 #include <fstream>
 #include <iterator>
+#include <map>
 #include <queue>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <llvm/ADT/Hashing.h>
 
 #include <llvm/Analysis/PostDominators.h>
 
+#include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+
+#include <llvm/Support/ThreadPool.h>
 
 #include <phasar/Utils/LLVMShorthands.h>
 
@@ -31,15 +45,129 @@ static const llvm::Value* POISON_PILL = reinterpret_cast<const llvm::Value*>("al
 static const std::vector<const llvm::Value*> EMPTY_SEQ;
 static const std::set<std::string> EMPTY_STRING_SET;
 
-static const std::string
-getTypeName(const llvm::Type* type)
+/*
+ * Dense ids for all values we keep per value tables for.
+ */
+static ValueNumbering valueNumbering;
+
+/*
+ * Memory location sequences and array decay flags only depend on the memory
+ * location materialization. Flow functions ask for them once per fact so we
+ * compute them once per value and keep them for the rest of the analysis.
+ * Note that references into an unordered_map stay valid on rehashing (callers
+ * hold on to sequences so they cannot live in a side table).
+ */
+static std::unordered_map<const llvm::Value*, const std::vector<const llvm::Value*>> memLocationSeqCache;
+static SideTable<bool> arrayDecayTable;
+
+/*
+ * Memory location sequences of the cache above. Sequences of two cached
+ * materializations are compared by node instead of part by part. We key the
+ * nodes by the storage of the cached vectors as sequences are passed around
+ * as views. Fact sequences are copies that come and go so they are never
+ * interned (see isFirstNMemoryLocationPartsEqual()).
+ */
+static MemoryLocationSeqTrie memLocationSeqTrie;
+static std::unordered_map<const llvm::Value* const*, MemoryLocationSeqTrie::NodeId> memLocationSeqNodes;
+
+/*
+ * Materialized constant expressions (i.e. global accesses).
+ */
+static DetachedInstructionTable detachedInstructionTable;
+
+/*
+ * Canonical form of a GEP memory location part. GEPs with the same pointer
+ * operand type and the same index constants share an index path id (this is
+ * the key the trie canonicalizes GEP parts by) so comparing two parts does
+ * not walk their indices. For array decaying we additionally keep whether the
+ * pointer index is zero and the last index.
+ */
+struct GEPPartDescriptor
 {
-  std::string typeName;
-  llvm::raw_string_ostream typeRawOutputStream(typeName);
-  type->print(typeRawOutputStream);
+  bool isValid;
+  unsigned int indexPathId;
+  unsigned int numIndices;
+  bool hasZeroPointerIndex;
+  const llvm::ConstantInt* lastIndex;
+};
 
-  return typeRawOutputStream.str();
-}
+using GEPIndexPath = std::pair<const llvm::Type*, std::vector<const llvm::Value*>>;
+
+static std::map<GEPIndexPath, unsigned int> gepIndexPathIds;
+static std::unordered_map<const llvm::GetElementPtrInst*, const GEPPartDescriptor> gepPartDescriptorCache;
+
+/*
+ * First GEP seen per index path id. Used in place of every other GEP with the
+ * same index path if fact sets are reduced (see canonicalizeMemoryLocationSeq()).
+ */
+static std::vector<const llvm::GetElementPtrInst*> canonicalGEPParts;
+
+/*
+ * Sanitized arg lists only depend on the call edge.
+ */
+static std::map<std::pair<const llvm::CallInst*, const llvm::Function*>, const SanitizedArgList> sanitizedArgListCache;
+
+/*
+ * End of tainted block for every block statement of the functions we have
+ * seen so far.
+ */
+static SideTable<const llvm::BasicBlock*> endOfTaintedBlockTable;
+static SideTable<bool> postDominatedFunctionTable;
+
+/*
+ * Labels of the end of tainted blocks handed out so far and the other way
+ * round. Facts only carry the label so we decode it with a single lookup.
+ */
+static std::unordered_map<const llvm::BasicBlock*, const std::string> endOfTaintedBlockLabels;
+static std::unordered_map<std::string, const llvm::BasicBlock*> endOfTaintedBlocksByLabel;
+
+/*
+ * Flow kind of every instruction of the functions we have seen so far.
+ */
+static SideTable<FlowKind> flowKindTable;
+
+/*
+ * Vararg roles of the functions we have seen so far. Functions are mapped to
+ * whether they use a va_list at all, only those have their instructions
+ * classified. For va_arg phis we keep the incoming address from memory.
+ */
+static SideTable<bool> vaListFunctionTable;
+static SideTable<VarArgRole> varArgRoleTable;
+static SideTable<const llvm::Value*> vaArgAddrMemLocationMatrTable;
+
+/*
+ * Debug location of every instruction of the functions we have seen so far.
+ * Callers hold on to locations so they cannot live in a side table.
+ */
+static std::unordered_map<const llvm::Instruction*, const DebugLocation> debugLocationCache;
+
+/*
+ * Current memory location sequence limit per function (nullptr for globals)
+ * in adaptive mode. We only need to know when another threshold many distinct
+ * sequences have been created so we keep the hashes of the sequences created
+ * since the limit has been lowered last. The longest sequence seen so far is
+ * where we start from if there is no global limit.
+ */
+struct MemoryLocationSeqLimit
+{
+  unsigned long limit;
+  std::size_t maxNumConcreteParts;
+  std::unordered_set<std::size_t> createdSeqHashes;
+};
+
+static std::unordered_map<const llvm::Function*, MemoryLocationSeqLimit> memLocationSeqLimits;
+
+/*
+ * Union and va_list types.
+ */
+static TypeClassificationTable typeClassificationTable;
+
+static unsigned long memLocationSeqCacheHits = 0;
+static unsigned long memLocationSeqCacheMisses = 0;
+static unsigned long arrayDecayCacheHits = 0;
+static unsigned long arrayDecayCacheMisses = 0;
+static unsigned long limitedMemLocationSeqs = 0;
+static unsigned long canonicalizedGEPParts = 0;
 
 static bool
 isMemoryLocationFrame(const llvm::Value* memLocationPart)
@@ -49,6 +177,37 @@ isMemoryLocationFrame(const llvm::Value* memLocationPart)
          llvm::isa<llvm::GlobalVariable>(memLocationPart);
 }
 
+/*
+ * Part that replaces the cut off parts of a limited memory location sequence
+ * (see limitMemoryLocationSeq()). It stands for any non empty suffix so it is
+ * equal to every part when checking for taint but never covered by a store.
+ * Real parts are frames and GEPs only so undef is free to be used.
+ */
+static const llvm::Value*
+getSummaryMemoryLocationPart(const llvm::Value* memLocationFrame)
+{
+  return llvm::UndefValue::get(llvm::Type::getInt8PtrTy(memLocationFrame->getContext()));
+}
+
+static bool
+isSummaryMemoryLocationPart(const llvm::Value* memLocationPart)
+{
+  return llvm::isa<llvm::UndefValue>(memLocationPart);
+}
+
+/*
+ * Number of parts before the summary part (i.e. all parts if the sequence has
+ * not been limited).
+ */
+static std::size_t
+getNumConcreteMemoryLocationParts(llvm::ArrayRef<const llvm::Value*> memLocationSeq)
+{
+  const auto summaryPart = std::find_if(memLocationSeq.begin(), memLocationSeq.end(),
+                                        isSummaryMemoryLocationPart);
+
+  return static_cast<std::size_t>(std::distance(memLocationSeq.begin(), summaryPart));
+}
+
 static bool
 isConstantIntEqual(const llvm::ConstantInt* ci1,
                    const llvm::ConstantInt* ci2)
@@ -60,72 +219,130 @@ isConstantIntEqual(const llvm::ConstantInt* ci1,
   return ci1 == ci2;
 }
 
+static const GEPPartDescriptor&
+getGEPPartDescriptor(const llvm::GetElementPtrInst* gepInst)
+{
+  const auto gepPartDescriptorEntry = gepPartDescriptorCache.find(gepInst);
+  if (gepPartDescriptorEntry != gepPartDescriptorCache.end()) return gepPartDescriptorEntry->second;
+
+  GEPPartDescriptor gepPartDescriptor = { false,
+                                          0,
+                                          gepInst->getNumIndices(),
+                                          false,
+                                          nullptr };
+
+  bool isDescribable = gepInst->getNumIndices() > 0 &&
+                       gepInst->hasAllConstantIndices();
+  if (isDescribable) {
+    GEPIndexPath gepIndexPath(gepInst->getPointerOperandType(),
+                              std::vector<const llvm::Value*>(gepInst->idx_begin(), gepInst->idx_end()));
+
+    const unsigned int indexPathId = static_cast<unsigned int>(gepIndexPathIds.size());
+
+    const auto gepIndexPathIdEntry = gepIndexPathIds.insert({ gepIndexPath, indexPathId });
+
+    bool isNewIndexPath = gepIndexPathIdEntry.second;
+    if (isNewIndexPath) canonicalGEPParts.push_back(gepInst);
+
+    gepPartDescriptor.isValid = true;
+    gepPartDescriptor.indexPathId = gepIndexPathIdEntry.first->second;
+    gepPartDescriptor.hasZeroPointerIndex = llvm::cast<llvm::ConstantInt>(gepInst->getOperand(1))->isZero();
+    gepPartDescriptor.lastIndex = llvm::cast<llvm::ConstantInt>(gepInst->getOperand(gepInst->getNumOperands() - 1));
+  }
+
+  return gepPartDescriptorCache.insert({ gepInst, gepPartDescriptor }).first->second;
+}
+
+/*
+ * Index constants are compared by identity (see isConstantIntEqual()) which
+ * is what sharing an index path id amounts to.
+ */
 static bool
 isGEPPartEqual(const llvm::GetElementPtrInst* memLocationFactGEP,
                const llvm::GetElementPtrInst* memLocationInstGEP)
 {
-  bool haveValidGEPParts = memLocationFactGEP->hasAllConstantIndices() &&
-                           memLocationInstGEP->hasAllConstantIndices();
+  const auto& factGEPDescriptor = getGEPPartDescriptor(memLocationFactGEP);
+  const auto& instGEPDescriptor = getGEPPartDescriptor(memLocationInstGEP);
+
+  bool haveValidGEPParts = factGEPDescriptor.isValid && instGEPDescriptor.isValid;
   if (!haveValidGEPParts) return false;
 
-  bool isNumIndicesEqual = memLocationFactGEP->getNumIndices() == memLocationInstGEP->getNumIndices();
+  bool isNumIndicesEqual = factGEPDescriptor.numIndices == instGEPDescriptor.numIndices;
+  if (isNumIndicesEqual) return factGEPDescriptor.indexPathId == instGEPDescriptor.indexPathId;
 
-  if (isNumIndicesEqual) {
-    // Compare pointer type
-    const auto gepFactPtrType = memLocationFactGEP->getPointerOperandType();
-    const auto gepInstPtrType = memLocationInstGEP->getPointerOperandType();
-    if (gepFactPtrType != gepInstPtrType) return false;
+  /*
+   * For now just expect this to be the result of array decaying...
+   *
+   * If we pass an array as an argument it is decayed to a pointer and loses type and
+   * size information. When we transfer the array from caller to callee we copy the GEP
+   * instruction from the caller as this is the only information we have. This GEP instruction
+   * carries type information:
+   *
+   * %arrayidx = getelementptr inbounds [42 x i32], [42 x i32]* %a, i64 0, i64 5
+   *
+   * However every GEP instruction for that array in the callee refers to the array as a pointer
+   * to the first element and performs pointer arithmetic in order to step through the elements.
+   * Thus the same location in the callee would be:
+   *
+   * %arrayidx = getelementptr inbounds i32, i32* %0, i64 5
+   *
+   * In order to be 100% accurate here we would also need to compare the pointer types...
+   */
+  const auto& nonDecayedArrayGEPDescriptor = factGEPDescriptor.numIndices > instGEPDescriptor.numIndices ?
+                                             factGEPDescriptor :
+                                             instGEPDescriptor;
+  if (!nonDecayedArrayGEPDescriptor.hasZeroPointerIndex) return false;
 
-    // Compare indices
-    for (unsigned int i = 1; i < memLocationFactGEP->getNumOperands(); i++) {
-      const auto* gepFactIndex = llvm::cast<llvm::ConstantInt>(memLocationFactGEP->getOperand(i));
-      const auto* gepInstIndex = llvm::cast<llvm::ConstantInt>(memLocationInstGEP->getOperand(i));
+  return isConstantIntEqual(factGEPDescriptor.lastIndex, instGEPDescriptor.lastIndex);
+}
 
-      if (!isConstantIntEqual(gepFactIndex, gepInstIndex)) return false;
-    }
-  }
-  else {
-    /*
-     * For now just expect this to be the result of array decaying...
-     *
-     * If we pass an array as an argument it is decayed to a pointer and loses type and
-     * size information. When we transfer the array from caller to callee we copy the GEP
-     * instruction from the caller as this is the only information we have. This GEP instruction
-     * carries type information:
-     *
-     * %arrayidx = getelementptr inbounds [42 x i32], [42 x i32]* %a, i64 0, i64 5
-     *
-     * However every GEP instruction for that array in the callee refers to the array as a pointer
-     * to the first element and performs pointer arithmetic in order to step through the elements.
-     * Thus the same location in the callee would be:
-     *
-     * %arrayidx = getelementptr inbounds i32, i32* %0, i64 5
-     *
-     * In order to be 100% accurate here we would also need to compare the pointer types...
-     */
-    const auto nonDecayedArrayGEP = memLocationFactGEP->getNumIndices() > memLocationInstGEP->getNumIndices() ?
-                                    memLocationFactGEP :
-                                    memLocationInstGEP;
+/*
+ * Replace every GEP part by the canonical GEP of its index path. Both share
+ * their descriptor so every comparison (and thus every GEN and KILL decision)
+ * treats them the same. Facts that are derived from canonical sequences and
+ * only differed in such GEP parts become equal and are merged by the solver.
+ */
+static void
+canonicalizeMemoryLocationSeq(std::vector<const llvm::Value*>& memLocationSeq)
+{
+  for (std::size_t i = 1; i < memLocationSeq.size(); ++i) {
+    const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationSeq[i]);
+    if (!gepInst) continue;
 
-    if (const auto nonDecayedArrayGEPPtrIndex = llvm::dyn_cast<llvm::ConstantInt>(nonDecayedArrayGEP->getOperand(1))) {
-      if (!nonDecayedArrayGEPPtrIndex->isZero()) return false;
-    }
-    else {
-      return false;
-    }
+    const auto& gepPartDescriptor = getGEPPartDescriptor(gepInst);
+    if (!gepPartDescriptor.isValid) continue;
 
-    const auto* gepFactIndex = llvm::cast<llvm::ConstantInt>(memLocationFactGEP->getOperand(memLocationFactGEP->getNumOperands() - 1));
-    const auto* gepInstIndex = llvm::cast<llvm::ConstantInt>(memLocationInstGEP->getOperand(memLocationInstGEP->getNumOperands() - 1));
+    const auto canonicalGEPPart = canonicalGEPParts[gepPartDescriptor.indexPathId];
+    if (canonicalGEPPart == gepInst) continue;
 
-    return isConstantIntEqual(gepFactIndex, gepInstIndex);
+    memLocationSeq[i] = canonicalGEPPart;
+    ++canonicalizedGEPParts;
   }
+}
+
+static void
+internMemoryLocationSeq(const std::vector<const llvm::Value*>& memLocationSeq)
+{
+  if (memLocationSeq.empty()) return;
+
+  memLocationSeqNodes.insert({ memLocationSeq.data(), memLocationSeqTrie.intern(memLocationSeq) });
+}
+
+static bool
+findMemoryLocationSeqNode(llvm::ArrayRef<const llvm::Value*> memLocationSeq,
+                          MemoryLocationSeqTrie::NodeId& node)
+{
+  const auto memLocationSeqNodeEntry = memLocationSeqNodes.find(memLocationSeq.data());
+  if (memLocationSeqNodeEntry == memLocationSeqNodes.end()) return false;
+
+  node = memLocationSeqNodeEntry->second;
 
   return true;
 }
 
 static bool
-isFirstNMemoryLocationPartsEqual(std::vector<const llvm::Value*> memLocationSeqFact,
-                                 std::vector<const llvm::Value*> memLocationSeqInst,
+isFirstNMemoryLocationPartsEqual(llvm::ArrayRef<const llvm::Value*> memLocationSeqFact,
+                                 llvm::ArrayRef<const llvm::Value*> memLocationSeqInst,
                                  std::size_t n)
 {
   assert(n > 0);
@@ -144,12 +361,47 @@ isFirstNMemoryLocationPartsEqual(std::vector<const llvm::Value*> memLocationSeqF
   bool isSameMemLocationFrame = memLocationSeqFact.front() == memLocationSeqInst.front();
   if (!isSameMemLocationFrame) return false;
 
-  for (std::size_t i = 1; i < n; ++i) {
-    const auto factGEPPtr = llvm::cast<llvm::GetElementPtrInst>(memLocationSeqFact[i]);
-    const auto instGEPPtr = llvm::cast<llvm::GetElementPtrInst>(memLocationSeqInst[i]);
+  MemoryLocationSeqTrie::NodeId factNode;
+  MemoryLocationSeqTrie::NodeId instNode;
+
+  bool areInternedSeqs = findMemoryLocationSeqNode(memLocationSeqFact, factNode) &&
+                         findMemoryLocationSeqNode(memLocationSeqInst, instNode);
+  if (!areInternedSeqs) {
+    for (std::size_t i = 1; i < n; ++i) {
+      const auto factGEPPtr = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationSeqFact[i]);
+      const auto instGEPPtr = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationSeqInst[i]);
+
+      bool haveGEPParts = factGEPPtr && instGEPPtr;
+      if (!haveGEPParts) return false;
+
+      bool isEqual = isGEPPartEqual(factGEPPtr, instGEPPtr);
+      if (!isEqual) return false;
+    }
+
+    return true;
+  }
+
+  /*
+   * Equal first n parts end in the same trie node. If the nodes differ we walk up
+   * until they meet (latest at the shared frame) as GEP parts with a different
+   * number of indices may still be equal due to array decaying.
+   */
+  factNode = memLocationSeqTrie.getAncestor(factNode, n);
+  instNode = memLocationSeqTrie.getAncestor(instNode, n);
+
+  bool haveValidGEPParts = memLocationSeqTrie.hasConstantIndices(factNode) &&
+                           memLocationSeqTrie.hasConstantIndices(instNode);
+  if (!haveValidGEPParts) return false;
+
+  while (factNode != instNode) {
+    const auto factGEPPtr = llvm::cast<llvm::GetElementPtrInst>(memLocationSeqTrie.getPart(factNode));
+    const auto instGEPPtr = llvm::cast<llvm::GetElementPtrInst>(memLocationSeqTrie.getPart(instNode));
 
     bool isEqual = isGEPPartEqual(factGEPPtr, instGEPPtr);
     if (!isEqual) return false;
+
+    factNode = memLocationSeqTrie.getParent(factNode);
+    instNode = memLocationSeqTrie.getParent(instNode);
   }
 
   return true;
@@ -159,9 +411,7 @@ static bool
 isUnionBitCast(const llvm::CastInst* castInst)
 {
   if (const auto bitCastInst = llvm::dyn_cast<llvm::BitCastInst>(castInst)) {
-    const auto typeName = getTypeName(bitCastInst->getSrcTy());
-
-    return typeName.find("union") != std::string::npos;
+    return typeClassificationTable.isUnion(bitCastInst->getSrcTy());
   }
   return false;
 }
@@ -171,7 +421,7 @@ getMemoryLocationSeqFromMatrRec(const llvm::Value* memLocationPart)
 {
   // Globals
   if (const auto constExpr = llvm::dyn_cast<llvm::ConstantExpr>(memLocationPart)) {
-    memLocationPart = const_cast<llvm::ConstantExpr*>(constExpr)->getAsInstruction();
+    memLocationPart = detachedInstructionTable.getAsInstruction(constExpr);
   }
 
   std::vector<const llvm::Value*> memLocationSeq;
@@ -214,6 +464,38 @@ getMemoryLocationSeqFromMatrRec(const llvm::Value* memLocationPart)
   return memLocationSeq;
 }
 
+/*
+ * Whether the memory location materialization can be walked without modifying
+ * anything, i.e. it involves neither globals (constant expressions are
+ * detached and global GEPs are split) nor casts from types that have not been
+ * classified yet. Such materializations are computed on the thread pool (see
+ * precompute()).
+ */
+static bool
+isReadOnlyMemoryLocationMatr(const llvm::Value* memLocationPart)
+{
+  bool isGlobal = llvm::isa<llvm::ConstantExpr>(memLocationPart) ||
+                  llvm::isa<llvm::GlobalVariable>(memLocationPart);
+  if (isGlobal) return false;
+
+  if (const auto castInst = llvm::dyn_cast<llvm::CastInst>(memLocationPart)) {
+    bool isClassifiedType = typeClassificationTable.isClassified(castInst->getSrcTy());
+    if (!isClassifiedType) return false;
+
+    return isReadOnlyMemoryLocationMatr(castInst->getOperand(0));
+  }
+  else
+  if (const auto loadInst = llvm::dyn_cast<llvm::LoadInst>(memLocationPart)) {
+    return isReadOnlyMemoryLocationMatr(loadInst->getOperand(0));
+  }
+  else
+  if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationPart)) {
+    return isReadOnlyMemoryLocationMatr(gepInst->getPointerOperand());
+  }
+
+  return true;
+}
+
 static const std::vector<const llvm::Value*>
 normalizeGlobalGEPs(const std::vector<const llvm::Value*> memLocationSeq)
 {
@@ -236,8 +518,12 @@ normalizeGlobalGEPs(const std::vector<const llvm::Value*> memLocationSeq)
 
     const std::vector<llvm::Value*> indices(gepInst->idx_begin(), gepInst->idx_end());
 
-    auto splittedGEPInst = llvm::GetElementPtrInst::CreateInBounds(const_cast<llvm::Value*>(normalizedMemLocationSeq.back()),
-                                                                   { indices[0], indices[1] }, "gepsplit0");
+    /*
+     * Split GEPs are canonical per (base, indices) so normalizing the same
+     * global path again yields the very same instructions.
+     */
+    auto splittedGEPInst = detachedInstructionTable.getSplitGEP(normalizedMemLocationSeq.back(),
+                                                                indices[0], indices[1], 0);
     normalizedMemLocationSeq.push_back(splittedGEPInst);
 
     llvm::ConstantInt* constantZero = llvm::ConstantInt::get(gepInst->getType()->getContext(),
@@ -246,11 +532,8 @@ normalizeGlobalGEPs(const std::vector<const llvm::Value*> memLocationSeq)
     for (std::size_t i = 2; i < indices.size(); ++i) {
       const auto index = indices[i];
 
-      std::stringstream nameStream;
-      nameStream << "gepsplit" << (i-1);
-
-      splittedGEPInst = llvm::GetElementPtrInst::CreateInBounds(const_cast<llvm::Value*>(normalizedMemLocationSeq.back()),
-                                                                { constantZero, index }, nameStream.str());
+      splittedGEPInst = detachedInstructionTable.getSplitGEP(normalizedMemLocationSeq.back(),
+                                                             constantZero, index, i - 1);
       normalizedMemLocationSeq.push_back(splittedGEPInst);
     }
   }
@@ -275,14 +558,28 @@ normalizeMemoryLocationSeq(std::vector<const llvm::Value*> memLocationSeq)
   return memLocationSeq;
 }
 
-const std::vector<const llvm::Value*>
+const std::vector<const llvm::Value*>&
 DataFlowUtils::getMemoryLocationSeqFromMatr(const llvm::Value* memLocationMatr)
 {
+  const auto memLocationSeqEntry = memLocationSeqCache.find(memLocationMatr);
+  if (memLocationSeqEntry != memLocationSeqCache.end()) {
+    ++memLocationSeqCacheHits;
+
+    return memLocationSeqEntry->second;
+  }
+
+  ++memLocationSeqCacheMisses;
+
   auto memLocationSeq = normalizeMemoryLocationSeq(getMemoryLocationSeqFromMatrRec(memLocationMatr));
 
   assert(memLocationSeq.empty() || isMemoryLocationFrame(memLocationSeq.front()));
 
-  return memLocationSeq;
+  if (isReduceFactSets()) canonicalizeMemoryLocationSeq(memLocationSeq);
+
+  const auto& cachedMemLocationSeq = memLocationSeqCache.insert({ memLocationMatr, memLocationSeq }).first->second;
+  internMemoryLocationSeq(cachedMemLocationSeq);
+
+  return cachedMemLocationSeq;
 }
 
 const std::vector<const llvm::Value*>
@@ -318,7 +615,7 @@ getVaListMemoryLocationFrameFromFact(const ExtendedValue& vaListFact)
 static const llvm::Value*
 getMemoryLocationFrameFromMatr(const llvm::Value* memLocationMatr)
 {
-  const auto memLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(memLocationMatr);
+  const auto& memLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(memLocationMatr);
   if (memLocationSeq.empty()) return nullptr;
 
   return memLocationSeq.front();
@@ -335,22 +632,39 @@ bool
 DataFlowUtils::isMemoryLocationTainted(const llvm::Value* memLocationMatr,
                                        const ExtendedValue& fact)
 {
-  auto memLocationInstSeq = getMemoryLocationSeqFromMatr(memLocationMatr);
+  llvm::ArrayRef<const llvm::Value*> memLocationInstSeq = getMemoryLocationSeqFromMatr(memLocationMatr);
   if (memLocationInstSeq.empty()) return false;
 
   const auto memLocationFactSeq = getMemoryLocationSeqFromFact(fact);
   if (memLocationFactSeq.empty()) return false;
 
   bool isArrayDecay = DataFlowUtils::isArrayDecay(memLocationMatr);
-  if (isArrayDecay) memLocationInstSeq.pop_back();
+  if (isArrayDecay) memLocationInstSeq = memLocationInstSeq.drop_back();
 
   return isSubsetMemoryLocationSeq(memLocationInstSeq,
                                    memLocationFactSeq);
 }
 
 bool
-DataFlowUtils::isMemoryLocationSeqsEqual(const std::vector<const llvm::Value*> memLocationSeq1,
-                                         const std::vector<const llvm::Value*> memLocationSeq2)
+DataFlowUtils::isMemoryLocationKilled(const llvm::Value* memLocationMatr,
+                                      const ExtendedValue& fact)
+{
+  llvm::ArrayRef<const llvm::Value*> memLocationInstSeq = getMemoryLocationSeqFromMatr(memLocationMatr);
+  if (memLocationInstSeq.empty()) return false;
+
+  const auto memLocationFactSeq = getMemoryLocationSeqFromFact(fact);
+  if (memLocationFactSeq.empty()) return false;
+
+  bool isArrayDecay = DataFlowUtils::isArrayDecay(memLocationMatr);
+  if (isArrayDecay) memLocationInstSeq = memLocationInstSeq.drop_back();
+
+  return isKilledMemoryLocationSeq(memLocationInstSeq,
+                                   memLocationFactSeq);
+}
+
+bool
+DataFlowUtils::isMemoryLocationSeqsEqual(llvm::ArrayRef<const llvm::Value*> memLocationSeq1,
+                                         llvm::ArrayRef<const llvm::Value*> memLocationSeq2)
 {
   bool isSizeEqual = memLocationSeq1.size() == memLocationSeq2.size();
   if (!isSizeEqual) return false;
@@ -358,7 +672,15 @@ DataFlowUtils::isMemoryLocationSeqsEqual(const std::vector<const llvm::Value*> m
   bool isEmptySeq = memLocationSeq1.empty();
   if (isEmptySeq) return false;
 
-  std::size_t n = memLocationSeq1.size();
+  /*
+   * Summary parts are not GEPs so we only compare the concrete parts and then
+   * make sure that either both or none of the sequences have been limited.
+   */
+  std::size_t n = getNumConcreteMemoryLocationParts(memLocationSeq1);
+
+  bool isNumConcretePartsEqual = n == getNumConcreteMemoryLocationParts(memLocationSeq2);
+  if (!isNumConcretePartsEqual) return false;
+
   bool isMemLocationsEqual = isFirstNMemoryLocationPartsEqual(memLocationSeq1,
                                                               memLocationSeq2,
                                                               n);
@@ -368,36 +690,57 @@ DataFlowUtils::isMemoryLocationSeqsEqual(const std::vector<const llvm::Value*> m
 }
 
 bool
-DataFlowUtils::isSubsetMemoryLocationSeq(const std::vector<const llvm::Value*> memLocationSeqInst,
-                                         const std::vector<const llvm::Value*> memLocationSeqFact)
+DataFlowUtils::isSubsetMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeqInst,
+                                         llvm::ArrayRef<const llvm::Value*> memLocationSeqFact)
 {
   if (memLocationSeqInst.empty()) return false;
   if (memLocationSeqFact.empty()) return false;
 
-  std::size_t n = std::min<std::size_t>(memLocationSeqInst.size(),
-                                        memLocationSeqFact.size());
+  // Summary parts are equal to any suffix
+  std::size_t n = std::min<std::size_t>(getNumConcreteMemoryLocationParts(memLocationSeqInst),
+                                        getNumConcreteMemoryLocationParts(memLocationSeqFact));
 
   return isFirstNMemoryLocationPartsEqual(memLocationSeqInst,
                                           memLocationSeqFact,
                                           n);
 }
 
-const std::vector<const llvm::Value*>
-DataFlowUtils::getRelocatableMemoryLocationSeq(const std::vector<const llvm::Value*> taintedMemLocationSeq,
-                                               const std::vector<const llvm::Value*> srcMemLocationSeq)
+/*
+ * Same as isSubsetMemoryLocationSeq() but a summary part of the fact is never
+ * covered by the store, i.e. a limited fact is only killed by a store to one
+ * of the parts it still contains.
+ */
+bool
+DataFlowUtils::isKilledMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeqInst,
+                                         llvm::ArrayRef<const llvm::Value*> memLocationSeqFact)
 {
-  std::vector<const llvm::Value*> relocatableMemLocationSeq;
+  std::size_t numConcreteFactParts = getNumConcreteMemoryLocationParts(memLocationSeqFact);
 
-  for (std::size_t i = srcMemLocationSeq.size(); i < taintedMemLocationSeq.size(); ++i) {
-    relocatableMemLocationSeq.push_back(taintedMemLocationSeq[i]);
-  }
+  bool isLimitedFact = numConcreteFactParts < memLocationSeqFact.size();
+  bool isSummaryPartStored = isLimitedFact && memLocationSeqInst.size() > numConcreteFactParts;
+  if (isSummaryPartStored) return false;
+
+  return isSubsetMemoryLocationSeq(memLocationSeqInst,
+                                   memLocationSeqFact);
+}
+
+/*
+ * The relocatable part is a view into the tainted memory location sequence. It
+ * must not outlive the sequence it has been taken from.
+ */
+llvm::ArrayRef<const llvm::Value*>
+DataFlowUtils::getRelocatableMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> taintedMemLocationSeq,
+                                               llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq)
+{
+  bool isRelocatable = srcMemLocationSeq.size() < taintedMemLocationSeq.size();
+  if (!isRelocatable) return llvm::ArrayRef<const llvm::Value*>();
 
-  return relocatableMemLocationSeq;
+  return taintedMemLocationSeq.drop_front(srcMemLocationSeq.size());
 }
 
 const std::vector<const llvm::Value*>
-DataFlowUtils::joinMemoryLocationSeqs(const std::vector<const llvm::Value*> memLocationSeq1,
-                                      const std::vector<const llvm::Value*> memLocationSeq2)
+DataFlowUtils::joinMemoryLocationSeqs(llvm::ArrayRef<const llvm::Value*> memLocationSeq1,
+                                      llvm::ArrayRef<const llvm::Value*> memLocationSeq2)
 {
   std::vector<const llvm::Value*> joinedMemLocationSeq;
   joinedMemLocationSeq.reserve(memLocationSeq1.size() + memLocationSeq2.size());
@@ -405,33 +748,23 @@ DataFlowUtils::joinMemoryLocationSeqs(const std::vector<const llvm::Value*> memL
   joinedMemLocationSeq.insert(joinedMemLocationSeq.end(), memLocationSeq1.begin(), memLocationSeq1.end());
   joinedMemLocationSeq.insert(joinedMemLocationSeq.end(), memLocationSeq2.begin(), memLocationSeq2.end());
 
+  limitMemoryLocationSeq(joinedMemLocationSeq);
+
   return joinedMemLocationSeq;
 }
 
-const std::vector<const llvm::Value*>
+static llvm::ArrayRef<const llvm::Value*>
 getVaListMemoryLocationSeq(const llvm::Value* value)
 {
-  if (const auto phiNodeInst = llvm::dyn_cast<llvm::PHINode>(value)) {
-    const auto phiNodeName = phiNodeInst->getName();
-    bool isVarArgAddr = phiNodeName.contains_lower("vaarg.addr");
-    if (!isVarArgAddr) return EMPTY_SEQ;
-
-    for (const auto& block : phiNodeInst->blocks()) {
-      const auto blockName = block->getName();
-      bool isVarArgInMem = blockName.contains_lower("vaarg.in_mem");
-      if (!isVarArgInMem) continue;
-
-      const auto vaListMemLocationMatr = phiNodeInst->getIncomingValueForBlock(block);
-      const auto vaListMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(vaListMemLocationMatr);
+  const auto phiNodeInst = llvm::dyn_cast<llvm::PHINode>(value);
+  if (!phiNodeInst) return EMPTY_SEQ;
 
-      bool isValidMemLocation = !vaListMemLocationSeq.empty();
-      if (!isValidMemLocation) return EMPTY_SEQ;
+  bool isVarArgAddr = DataFlowUtils::getVarArgRole(phiNodeInst) == VarArgRole::VA_ARG_ADDR;
+  if (!isVarArgAddr) return EMPTY_SEQ;
 
-      return vaListMemLocationSeq;
-    }
-  }
+  const auto vaListMemLocationMatr = *vaArgAddrMemLocationMatrTable.find(valueNumbering.getId(phiNodeInst));
 
-  return EMPTY_SEQ;
+  return DataFlowUtils::getMemoryLocationSeqFromMatr(vaListMemLocationMatr);
 }
 
 static bool
@@ -468,7 +801,7 @@ DataFlowUtils::isPatchableArgumentStore(const llvm::Value* srcValue,
    * Patch of varargs passed through '...'
    */
   if (isVarArgFact) {
-    bool isIndexEqual = fact.getVarArgIndex() == fact.getCurrentVarArgIndex();
+    bool isIndexEqual = isVarArgIndexTainted(fact, fact.getCurrentVarArgIndex());
     if (!isIndexEqual) return false;
 
     if (const auto loadInst = llvm::dyn_cast<llvm::LoadInst>(srcValue)) {
@@ -498,13 +831,13 @@ DataFlowUtils::isPatchableVaListArgument(const llvm::Value* srcValue,
 
 bool
 DataFlowUtils::isPatchableArgumentMemcpy(const llvm::Value* srcValue,
-                                         const std::vector<const llvm::Value*> srcMemLocationSeq,
+                                         llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq,
                                          const ExtendedValue& fact)
 {
   bool isVarArgFact = fact.isVarArg();
   if (!isVarArgFact) return false;
 
-  bool isIndexEqual = fact.getVarArgIndex() == fact.getCurrentVarArgIndex();
+  bool isIndexEqual = isVarArgIndexTainted(fact, fact.getCurrentVarArgIndex());
   if (!isIndexEqual) return false;
 
   bool isSrcMemLocation = !srcMemLocationSeq.empty();
@@ -558,8 +891,8 @@ DataFlowUtils::isPatchableReturnValue(const llvm::Value* srcValue,
 }
 
 const std::vector<const llvm::Value*>
-DataFlowUtils::patchMemoryLocationFrame(const std::vector<const llvm::Value*> patchableMemLocationSeq,
-                                        const std::vector<const llvm::Value*> patchMemLocationSeq)
+DataFlowUtils::patchMemoryLocationFrame(llvm::ArrayRef<const llvm::Value*> patchableMemLocationSeq,
+                                        llvm::ArrayRef<const llvm::Value*> patchMemLocationSeq)
 {
   if (patchableMemLocationSeq.empty()) return EMPTY_SEQ;
   if (patchMemLocationSeq.empty()) return EMPTY_SEQ;
@@ -570,6 +903,8 @@ DataFlowUtils::patchMemoryLocationFrame(const std::vector<const llvm::Value*> pa
   patchedMemLocationSeq.insert(patchedMemLocationSeq.end(), patchMemLocationSeq.begin(), patchMemLocationSeq.end());
   patchedMemLocationSeq.insert(patchedMemLocationSeq.end(), std::next(patchableMemLocationSeq.begin()), patchableMemLocationSeq.end());
 
+  limitMemoryLocationSeq(patchedMemLocationSeq);
+
   return patchedMemLocationSeq;
 }
 
@@ -577,7 +912,7 @@ static long
 getNumCoercedArgs(const llvm::Value* value)
 {
   if (const auto constExpr = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
-    value = const_cast<llvm::ConstantExpr*>(constExpr)->getAsInstruction();
+    value = detachedInstructionTable.getAsInstruction(constExpr);
   }
 
   if (llvm::isa<llvm::AllocaInst>(value) ||
@@ -644,22 +979,20 @@ getNumCoercedArgs(const llvm::Value* value)
  * GEP indexes are different (there is no GEP 2 anymore). So we just ignore
  * the GEP value and pop it from the memory location and proceed as usual.
  */
-const std::vector<std::tuple<const llvm::Value*,
-                             const std::vector<const llvm::Value*>,
-                             const llvm::Value*>>
-DataFlowUtils::getSanitizedArgList(const llvm::CallInst* callInst,
-                                   const llvm::Function* destMthd,
-                                   const llvm::Value* zeroValue)
+static const SanitizedArgList
+createSanitizedArgList(const llvm::CallInst* callInst,
+                       const llvm::Function* destMthd,
+                       const llvm::Value* zeroValue)
 {
-  std::vector<std::tuple<const llvm::Value*,
-              const std::vector<const llvm::Value*>,
-              const llvm::Value*>> sanitizedArgList;
+  SanitizedArgList sanitizedArgList;
+
+  long varArgIndex = 0L;
 
   for (unsigned i = 0; i < callInst->getNumArgOperands(); ++i) {
     const auto arg = callInst->getOperand(i);
     const auto param = getNthFunctionArgument(destMthd, i);
 
-    auto argMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(arg);
+    llvm::ArrayRef<const llvm::Value*> argMemLocationSeq = DataFlowUtils::getMemoryLocationSeqFromMatr(arg);
 
     long numCoersedArgs = getNumCoercedArgs(arg);
     bool isCoersedArg = numCoersedArgs > 0;
@@ -667,83 +1000,186 @@ DataFlowUtils::getSanitizedArgList(const llvm::CallInst* callInst,
     bool isArrayDecay = DataFlowUtils::isArrayDecay(arg);
 
     if (isCoersedArg) {
-      argMemLocationSeq.pop_back();
+      argMemLocationSeq = argMemLocationSeq.drop_back();
       i += numCoersedArgs - 1;
     }
     else
     if (isArrayDecay) {
-      argMemLocationSeq.pop_back();
+      argMemLocationSeq = argMemLocationSeq.drop_back();
     }
 
     const auto sanitizedParam = param ? param : zeroValue;
 
-    sanitizedArgList.push_back(std::make_tuple(arg, argMemLocationSeq, sanitizedParam));
+    bool isVarArgParam = DataFlowUtils::isVarArgParam(sanitizedParam, zeroValue);
+
+    const auto argIndex = sanitizedArgList.args.size();
+    sanitizedArgList.args.push_back({ arg,
+                                      argMemLocationSeq,
+                                      sanitizedParam,
+                                      isVarArgParam ? varArgIndex : -1L });
+
+    bool isArgMemLocation = !argMemLocationSeq.empty();
+    if (isArgMemLocation) {
+      sanitizedArgList.memLocationFrameArgIndices[argMemLocationSeq.front()].push_back(argIndex);
+    }
+    else {
+      sanitizedArgList.valueArgIndices[arg].push_back(argIndex);
+    }
+
+    if (isVarArgParam) ++varArgIndex;
   }
 
   return sanitizedArgList;
 }
 
-static const std::vector<llvm::BasicBlock*>
-getPostDominators(const llvm::DomTreeNodeBase<llvm::BasicBlock>* postDomTreeNode,
-                  const llvm::BasicBlock* startBasicBlock)
+const SanitizedArgList&
+DataFlowUtils::getSanitizedArgList(const llvm::CallInst* callInst,
+                                   const llvm::Function* destMthd,
+                                   const llvm::Value* zeroValue)
 {
-  const auto currentBasicBlock = postDomTreeNode->getBlock();
-  bool isStartBasicBlock = currentBasicBlock == startBasicBlock;
+  const auto callEdge = std::make_pair(callInst, destMthd);
 
-  if (isStartBasicBlock) return { currentBasicBlock };
+  const auto sanitizedArgListEntry = sanitizedArgListCache.find(callEdge);
+  if (sanitizedArgListEntry != sanitizedArgListCache.end()) return sanitizedArgListEntry->second;
 
-  for (const auto postDomTreeChild : postDomTreeNode->getChildren()) {
-    auto childNodes = getPostDominators(postDomTreeChild,
-                                        startBasicBlock);
-    if (!childNodes.empty()) {
-      childNodes.push_back(currentBasicBlock);
+  const auto sanitizedArgList = createSanitizedArgList(callInst, destMthd, zeroValue);
 
-      return childNodes;
-    }
+  return sanitizedArgListCache.insert({ callEdge, sanitizedArgList }).first->second;
+}
+
+static bool
+isBlockStatement(const llvm::BasicBlock* basicBlock)
+{
+  const auto terminatorInst = basicBlock->getTerminator();
+
+  return llvm::isa<llvm::BranchInst>(terminatorInst) ||
+         llvm::isa<llvm::SwitchInst>(terminatorInst);
+}
+
+using EndOfTaintedBlocks = std::vector<std::pair<const llvm::BasicBlock*, const llvm::BasicBlock*>>;
+
+/*
+ * The end of a tainted block is the immediate post dominator of the block
+ * containing the tainted branch. If it is the virtual exit (multiple return
+ * statements) the taint lasts until the end of the function. We compute the
+ * post dominator tree once per function and store the result for every block
+ * statement in it.
+ *
+ * Only reads the IR so it can be run for different functions in parallel.
+ */
+static EndOfTaintedBlocks
+computeEndOfTaintedBlocks(const llvm::Function* function)
+{
+  llvm::PostDominatorTree postDominatorTree;
+  postDominatorTree.recalculate(*const_cast<llvm::Function*>(function));
+
+  EndOfTaintedBlocks endOfTaintedBlocks;
+
+  for (const auto& basicBlock : *function) {
+    bool isBlockStmt = isBlockStatement(&basicBlock);
+    if (!isBlockStmt) continue;
+
+    const auto postDomTreeNode = postDominatorTree.getNode(const_cast<llvm::BasicBlock*>(&basicBlock));
+    const auto immediatePostDomTreeNode = postDomTreeNode ? postDomTreeNode->getIDom() : nullptr;
+
+    endOfTaintedBlocks.push_back({ &basicBlock, immediatePostDomTreeNode ? immediatePostDomTreeNode->getBlock() : nullptr });
   }
 
-  return std::vector<llvm::BasicBlock*>();
+  return endOfTaintedBlocks;
+}
+
+static void
+storeEndOfTaintedBlocks(const llvm::Function* function,
+                        const EndOfTaintedBlocks& endOfTaintedBlocks)
+{
+  const ValueId functionId = valueNumbering.getId(function);
+
+  bool isPostDominatedFunction = postDominatedFunctionTable.find(functionId);
+  if (isPostDominatedFunction) return;
+
+  postDominatedFunctionTable.insert(functionId, true);
+
+  for (const auto& endOfTaintedBlock : endOfTaintedBlocks) {
+    endOfTaintedBlockTable.insert(valueNumbering.getId(endOfTaintedBlock.first), endOfTaintedBlock.second);
+  }
 }
 
 const llvm::BasicBlock*
 DataFlowUtils::getEndOfTaintedBlock(const llvm::BasicBlock* startBasicBlock)
 {
-  const auto terminatorInst = startBasicBlock->getTerminator();
-  const auto function = const_cast<llvm::Function*>(startBasicBlock->getParent());
+  bool isBlockStmt = isBlockStatement(startBasicBlock);
+  if (!isBlockStmt) return nullptr;
 
-  bool isBlockStatement = llvm::isa<llvm::BranchInst>(terminatorInst) ||
-                          llvm::isa<llvm::SwitchInst>(terminatorInst);
-  if (!isBlockStatement) return nullptr;
+  const auto function = startBasicBlock->getParent();
 
-  llvm::PostDominatorTree postDominatorTree;
-  postDominatorTree.recalculate(*function);
+  bool isPostDominatedFunction = postDominatedFunctionTable.find(valueNumbering.getId(function));
+  if (!isPostDominatedFunction) storeEndOfTaintedBlocks(function, computeEndOfTaintedBlocks(function));
+
+  const auto endOfTaintedBlock = endOfTaintedBlockTable.find(valueNumbering.getId(startBasicBlock));
+  if (!endOfTaintedBlock) return nullptr;
+
+  return *endOfTaintedBlock;
+}
+
+/*
+ * The label of the end of a tainted block is not its name (might be empty or
+ * ambiguous across functions) but the dense id of the basic block prefixed by
+ * END_OF_TAINTED_BLOCK_LABEL_PREFIX. Ids are assigned in module order so the
+ * label (and thus the ordering of facts) is deterministic. An empty label
+ * denotes that the taint lasts until the end of the function.
+ */
+static const std::string END_OF_TAINTED_BLOCK_LABEL_PREFIX = "bb.";
+
+const std::string
+DataFlowUtils::getEndOfTaintedBlockLabel(const llvm::BasicBlock* endBasicBlock)
+{
+  if (!endBasicBlock) return std::string();
+
+  const auto endOfTaintedBlockLabelEntry = endOfTaintedBlockLabels.find(endBasicBlock);
+  if (endOfTaintedBlockLabelEntry != endOfTaintedBlockLabels.end()) return endOfTaintedBlockLabelEntry->second;
+
+  const std::string endOfTaintedBlockLabel = END_OF_TAINTED_BLOCK_LABEL_PREFIX + std::to_string(valueNumbering.getId(endBasicBlock));
+
+  endOfTaintedBlocksByLabel.insert({ endOfTaintedBlockLabel, endBasicBlock });
+
+  return endOfTaintedBlockLabels.insert({ endBasicBlock, endOfTaintedBlockLabel }).first->second;
+}
 
-  const auto postDominators = getPostDominators(postDominatorTree.getRootNode(),
-                                                startBasicBlock);
+/*
+ * Every label has been handed out by getEndOfTaintedBlockLabel() so we never
+ * need to parse it.
+ */
+const llvm::BasicBlock*
+DataFlowUtils::getEndOfTaintedBlockFromFact(const ExtendedValue& fact)
+{
+  const auto endOfTaintedBlockLabel = fact.getEndOfTaintedBlockLabel();
+  if (endOfTaintedBlockLabel.empty()) return nullptr;
 
-  return postDominators.size() > 1 ? postDominators[1] : nullptr;
+  const auto endOfTaintedBlockEntry = endOfTaintedBlocksByLabel.find(endOfTaintedBlockLabel);
+  if (endOfTaintedBlockEntry == endOfTaintedBlocksByLabel.end()) return nullptr;
+
+  return endOfTaintedBlockEntry->second;
 }
 
 /*
  * We are removing the tainted branch instruction from facts if the instruction's
- * basic block label matches the one of the tainted branch end block. Note that
- * we remove it after the phi node making sure that the phi node is auto added
- * whenever we came from a tainted branch.
+ * basic block is the tainted branch end block. Note that we remove it after the
+ * phi node making sure that the phi node is auto added whenever we came from a
+ * tainted branch.
  */
 bool
 DataFlowUtils::removeTaintedBlockInst(const ExtendedValue& fact,
                                       const llvm::Instruction* currentInst)
 {
-  bool isEndOfFunctionTaint = fact.getEndOfTaintedBlockLabel().empty();
+  const auto endBasicBlock = getEndOfTaintedBlockFromFact(fact);
+
+  bool isEndOfFunctionTaint = !endBasicBlock;
   if (isEndOfFunctionTaint) return false;
 
   bool isPhiNode = llvm::isa<llvm::PHINode>(currentInst);
   if (isPhiNode) return false;
 
-  const auto currentBB = currentInst->getParent();
-  const auto currentLabel = currentBB->getName();
-
-  return currentLabel == fact.getEndOfTaintedBlockLabel();
+  return currentInst->getParent() == endBasicBlock;
 }
 
 bool
@@ -756,14 +1192,136 @@ DataFlowUtils::isAutoGENInTaintedBlock(const llvm::Instruction* currentInst)
          !llvm::isa<llvm::ReturnInst>(currentInst);
 }
 
-bool
-DataFlowUtils::isMemoryLocationFact(const ExtendedValue& ev)
+static bool
+isEnvVarSet(const char* envVar)
 {
-  return !ev.getMemLocationSeq().empty();
+  const char* value = std::getenv(envVar);
+
+  bool isSet = value && std::string(value) != "0";
+  LOG_INFO(envVar << (isSet ? " set" : " unset"));
+
+  return isSet;
 }
 
+/*
+ * In compact tainted block mode we do not GEN a fact for every instruction in
+ * a tainted block. Instead the block (i.e. region from the tainted branch to
+ * its end) is recorded once in the trace stats and expanded to line numbers
+ * when writing the report. Only values that escape their basic block are
+ * still added as facts.
+ */
 bool
-DataFlowUtils::isKillAfterStoreFact(const ExtendedValue& ev)
+DataFlowUtils::isCompactTaintedBlocks()
+{
+  static const bool isCompactTaintedBlocks = isEnvVarSet("COMPACT_TAINTED_BLOCKS");
+
+  return isCompactTaintedBlocks;
+}
+
+/*
+ * Facts whose memory location sequences only differ in GEPs with the same
+ * index path are merged. Off by default as dumped facts then show GEPs of
+ * other instructions (or functions).
+ */
+bool
+DataFlowUtils::isReduceFactSets()
+{
+  static const bool isReduceFactSets = isEnvVarSet("REDUCE_FACT_SETS");
+
+  return isReduceFactSets;
+}
+
+static unsigned long
+readNumberFromEnvVar(const char* envVar)
+{
+  const char* value = std::getenv(envVar);
+  if (!value) {
+    LOG_INFO(envVar << " unset");
+    return 0;
+  }
+
+  unsigned long number = std::strtoul(value, nullptr, 10);
+  LOG_INFO(envVar << " set to: " << number);
+
+  return number;
+}
+
+/*
+ * Max number of memoized computeTargets() results (0 disables memoization).
+ */
+unsigned long
+DataFlowUtils::getComputeTargetsMemoSize()
+{
+  static const unsigned long computeTargetsMemoSize = readNumberFromEnvVar("COMPUTE_TARGETS_MEMO_SIZE");
+
+  /*
+   * With adaptive sequence limits flow functions are not pure anymore (the
+   * same fact may be limited differently later on) so we must not memoize.
+   */
+  bool isAdaptiveSeqLimit = getAdaptiveSeqLimitThreshold() > 0;
+  if (isAdaptiveSeqLimit) return 0;
+
+  return computeTargetsMemoSize;
+}
+
+/*
+ * Max number of parts of a memory location sequence that is created by a
+ * flow function (0 means unlimited).
+ */
+unsigned long
+DataFlowUtils::getMemoryLocationSeqLimit()
+{
+  static const unsigned long memLocationSeqLimit = readNumberFromEnvVar("MEMORY_LOCATION_SEQ_LIMIT");
+
+  return memLocationSeqLimit;
+}
+
+/*
+ * Number of distinct sequences a function may create before its sequence
+ * limit is lowered by one (0 disables the adaptive mode).
+ */
+unsigned long
+DataFlowUtils::getAdaptiveSeqLimitThreshold()
+{
+  static const unsigned long adaptiveSeqLimitThreshold = readNumberFromEnvVar("ADAPTIVE_SEQ_LIMIT_THRESHOLD");
+
+  return adaptiveSeqLimitThreshold;
+}
+
+/*
+ * A value escapes if it might be needed by a fact outside of its own basic
+ * block: it is used in another block, written to memory, passed to a call,
+ * returned or decides control flow.
+ */
+bool
+DataFlowUtils::isEscapingValue(const llvm::Instruction* currentInst)
+{
+  for (const auto user : currentInst->users()) {
+    const auto userInst = llvm::dyn_cast<llvm::Instruction>(user);
+    if (!userInst) return true;
+
+    bool isEscapingUser = userInst->getParent() != currentInst->getParent() ||
+                          llvm::isa<llvm::StoreInst>(userInst) ||
+                          llvm::isa<llvm::CallInst>(userInst) ||
+                          llvm::isa<llvm::InvokeInst>(userInst) ||
+                          llvm::isa<llvm::ReturnInst>(userInst) ||
+                          llvm::isa<llvm::PHINode>(userInst) ||
+                          llvm::isa<llvm::BranchInst>(userInst) ||
+                          llvm::isa<llvm::SwitchInst>(userInst);
+    if (isEscapingUser) return true;
+  }
+
+  return false;
+}
+
+bool
+DataFlowUtils::isMemoryLocationFact(const ExtendedValue& ev)
+{
+  return !ev.getMemLocationSeq().empty();
+}
+
+bool
+DataFlowUtils::isKillAfterStoreFact(const ExtendedValue& ev)
 {
   return !isMemoryLocationFact(ev) &&
          !llvm::isa<llvm::CallInst>(ev.getValue());
@@ -781,6 +1339,63 @@ DataFlowUtils::isCheckOperandsInst(const llvm::Instruction* currentInst)
          llvm::isa<llvm::SelectInst>(currentInst);
 }
 
+static FlowKind
+classifyFlowKind(const llvm::Instruction* currentInst)
+{
+  if (llvm::isa<llvm::StoreInst>(currentInst)) return FlowKind::STORE;
+
+  if (llvm::isa<llvm::BranchInst>(currentInst) ||
+      llvm::isa<llvm::SwitchInst>(currentInst)) return FlowKind::BRANCH_SWITCH;
+
+  if (llvm::isa<llvm::GetElementPtrInst>(currentInst)) return FlowKind::GEP;
+
+  if (llvm::isa<llvm::PHINode>(currentInst)) return FlowKind::PHI_NODE;
+
+  if (DataFlowUtils::isCheckOperandsInst(currentInst)) return FlowKind::CHECK_OPERANDS;
+
+  return FlowKind::IDENTITY;
+}
+
+using FlowKinds = std::vector<std::pair<const llvm::Instruction*, FlowKind>>;
+
+static FlowKinds
+classifyFlowKinds(const llvm::Function* function)
+{
+  FlowKinds flowKinds;
+
+  for (const auto& basicBlock : *function) {
+    for (const auto& instruction : basicBlock) {
+      flowKinds.push_back({ &instruction, classifyFlowKind(&instruction) });
+    }
+  }
+
+  return flowKinds;
+}
+
+static void
+storeFlowKinds(const FlowKinds& flowKinds)
+{
+  for (const auto& flowKind : flowKinds) {
+    flowKindTable.insert(valueNumbering.getId(flowKind.first), flowKind.second);
+  }
+}
+
+/*
+ * Instructions are classified once per function.
+ */
+FlowKind
+DataFlowUtils::getFlowKind(const llvm::Instruction* currentInst)
+{
+  const ValueId currentInstId = valueNumbering.getId(currentInst);
+
+  const auto flowKind = flowKindTable.find(currentInstId);
+  if (flowKind) return *flowKind;
+
+  storeFlowKinds(classifyFlowKinds(currentInst->getFunction()));
+
+  return *flowKindTable.find(currentInstId);
+}
+
 bool
 DataFlowUtils::isAutoIdentity(const llvm::Instruction* currentInst,
                               const ExtendedValue& fact)
@@ -807,7 +1422,7 @@ DataFlowUtils::isAutoIdentity(const llvm::Instruction* currentInst,
     if (isArgumentPatch) return false;
 
     const auto dstMemLocationMatr = storeInst->getPointerOperand();
-    const auto dstMemLocationSeq = getMemoryLocationSeqFromMatr(dstMemLocationMatr);
+    const auto& dstMemLocationSeq = getMemoryLocationSeqFromMatr(dstMemLocationMatr);
 
     bool isDstMemLocation = !dstMemLocationSeq.empty();
     if (isDstMemLocation) {
@@ -828,34 +1443,323 @@ DataFlowUtils::isVarArgParam(const llvm::Value* param,
   return param == zeroValue;
 }
 
+/*
+ * A vararg fact either carries the index of the single tainted vararg or a
+ * set of tainted varargs. Sets are encoded as a bitmask of the indices in the
+ * varArgIndex field with VAR_ARG_INDEX_SET as marker bit so that they are
+ * still recognized as varargs (varArgIndex > -1). The current vararg index
+ * works as cursor for both. Indices that do not fit into the mask are kept as
+ * single index facts.
+ */
+static const long VAR_ARG_INDEX_SET = 1L << 62;
+static const long MAX_VAR_ARG_SET_INDEX = 62;
+
+static bool
+isVarArgIndexSet(long varArgIndex)
+{
+  return varArgIndex > -1 && (varArgIndex & VAR_ARG_INDEX_SET);
+}
+
+static long
+toVarArgIndexSet(long varArgIndex)
+{
+  if (isVarArgIndexSet(varArgIndex)) return varArgIndex;
+
+  bool isRepresentable = varArgIndex > -1 && varArgIndex < MAX_VAR_ARG_SET_INDEX;
+  if (!isRepresentable) return -1;
+
+  return VAR_ARG_INDEX_SET | (1L << varArgIndex);
+}
+
 bool
-DataFlowUtils::isVaListType(const llvm::Type* type)
+DataFlowUtils::isVarArgIndexTainted(const ExtendedValue& fact,
+                                    long varArgIndex)
+{
+  long factVarArgIndex = fact.getVarArgIndex();
+
+  bool isIndexSet = isVarArgIndexSet(factVarArgIndex);
+  if (!isIndexSet) return factVarArgIndex == varArgIndex;
+
+  bool isInMask = varArgIndex > -1 && varArgIndex < MAX_VAR_ARG_SET_INDEX;
+  if (!isInMask) return false;
+
+  return factVarArgIndex & (1L << varArgIndex);
+}
+
+/*
+ * Returns -1 if the indices cannot be represented by a single set.
+ */
+long
+DataFlowUtils::joinVarArgIndices(long varArgIndex1,
+                                 long varArgIndex2)
+{
+  if (varArgIndex1 == varArgIndex2) return varArgIndex1;
+
+  long varArgIndexSet1 = toVarArgIndexSet(varArgIndex1);
+  long varArgIndexSet2 = toVarArgIndexSet(varArgIndex2);
+
+  bool isJoinable = varArgIndexSet1 > -1 && varArgIndexSet2 > -1;
+  if (!isJoinable) return -1;
+
+  return varArgIndexSet1 | varArgIndexSet2;
+}
+
+/*
+ * Returns -1 if no tainted index is left.
+ */
+long
+DataFlowUtils::removeVarArgIndex(long varArgIndex,
+                                 long removedVarArgIndex)
 {
-  const auto typeName = getTypeName(type);
+  bool isIndexSet = isVarArgIndexSet(varArgIndex);
+  if (!isIndexSet) return varArgIndex == removedVarArgIndex ? -1 : varArgIndex;
 
-  return typeName.find("%struct.__va_list_tag") != std::string::npos;
+  bool isInMask = removedVarArgIndex > -1 && removedVarArgIndex < MAX_VAR_ARG_SET_INDEX;
+  if (isInMask) varArgIndex &= ~(1L << removedVarArgIndex);
+
+  bool isEmpty = varArgIndex == VAR_ARG_INDEX_SET;
+  if (isEmpty) return -1;
+
+  return varArgIndex;
+}
+
+/*
+ * When a vararg of an index set has been patched the other varargs of the set
+ * are still to be patched. Returns the fact for them (if any).
+ */
+const std::set<ExtendedValue>
+DataFlowUtils::getRemainingVarArgFacts(const ExtendedValue& patchedFact)
+{
+  if (!patchedFact.isVarArg()) return { };
+
+  long remainingVarArgIndex = removeVarArgIndex(patchedFact.getVarArgIndex(),
+                                                patchedFact.getCurrentVarArgIndex());
+
+  bool hasRemainingVarArgs = remainingVarArgIndex > -1 &&
+                             remainingVarArgIndex != patchedFact.getVarArgIndex();
+  if (!hasRemainingVarArgs) return { };
+
+  ExtendedValue remainingFact(patchedFact);
+  remainingFact.setVarArgIndex(remainingVarArgIndex);
+
+  return { remainingFact };
+}
+
+/*
+ * Merge vararg facts that only differ in their tainted index into a single
+ * fact with an index set. E.g. passing the same tainted value as several
+ * varargs yields one fact instead of one per position.
+ */
+void
+DataFlowUtils::compressVarArgFacts(std::set<ExtendedValue>& facts)
+{
+  std::set<ExtendedValue> compressedFacts;
+  std::map<ExtendedValue, long> varArgIndices;
+
+  for (const auto& fact : facts) {
+    bool isVarArgFact = fact.isVarArg();
+    if (!isVarArgFact) {
+      compressedFacts.insert(fact);
+      continue;
+    }
+
+    ExtendedValue factWithoutIndex(fact);
+    factWithoutIndex.setVarArgIndex(-1);
+
+    const auto varArgIndexEntry = varArgIndices.find(factWithoutIndex);
+    if (varArgIndexEntry == varArgIndices.end()) {
+      varArgIndices.insert({ factWithoutIndex, fact.getVarArgIndex() });
+      continue;
+    }
+
+    long joinedVarArgIndex = joinVarArgIndices(varArgIndexEntry->second, fact.getVarArgIndex());
+    if (joinedVarArgIndex < 0) {
+      compressedFacts.insert(fact);
+      continue;
+    }
+
+    varArgIndexEntry->second = joinedVarArgIndex;
+  }
+
+  if (varArgIndices.size() == facts.size() - compressedFacts.size()) return;
+
+  for (const auto& varArgIndexEntry : varArgIndices) {
+    ExtendedValue ev(varArgIndexEntry.first);
+    ev.setVarArgIndex(varArgIndexEntry.second);
+
+    compressedFacts.insert(ev);
+  }
+
+  facts = compressedFacts;
 }
 
 bool
-DataFlowUtils::isReturnValue(const llvm::Instruction* currentInst,
-                             const llvm::Instruction* successorInst)
+DataFlowUtils::isVaListType(const llvm::Type* type)
 {
-  bool isSuccessorRetVal = llvm::isa<llvm::ReturnInst>(successorInst);
-  if (!isSuccessorRetVal) return false;
+  return typeClassificationTable.isVaList(type);
+}
 
-  if (const auto binaryOpInst = llvm::dyn_cast<llvm::BinaryOperator>(currentInst)) {
-    bool isMagicOpCode = binaryOpInst->getOpcode() == 20;
-    if (!isMagicOpCode) return false;
+static const long VA_LIST_OVERFLOW_ARG_AREA = 2;
+static const long VA_LIST_REG_SAVE_AREA = 3;
 
-    bool isMagicType = getTypeName(binaryOpInst->getType()) == "i4711";
-    if (!isMagicType) return false;
+/*
+ * Field of the va_list that the value has been loaded from, -1 otherwise
+ * (load (gep %struct.__va_list_tag* %ap, 0, <field>)).
+ */
+static long
+getLoadedVaListField(const llvm::Value* value)
+{
+  const auto loadInst = llvm::dyn_cast<llvm::LoadInst>(value->stripPointerCasts());
+  if (!loadInst) return -1;
 
-    return true;
+  const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(loadInst->getPointerOperand());
+  if (!gepInst) return -1;
+
+  bool isVaListFieldAccess = gepInst->getNumIndices() == 2 &&
+                             gepInst->getSourceElementType()->isStructTy() &&
+                             DataFlowUtils::isVaListType(gepInst->getSourceElementType());
+  if (!isVaListFieldAccess) return -1;
+
+  const auto fieldIndex = llvm::dyn_cast<llvm::ConstantInt>(gepInst->getOperand(2));
+  if (!fieldIndex) return -1;
+
+  return fieldIndex->getSExtValue();
+}
+
+static bool
+isStoredToLoadedVaListField(const llvm::GetElementPtrInst* gepInst)
+{
+  const auto loadInst = llvm::cast<llvm::LoadInst>(gepInst->getPointerOperand()->stripPointerCasts());
+
+  for (const auto user : gepInst->users()) {
+    if (const auto storeInst = llvm::dyn_cast<llvm::StoreInst>(user)) {
+      bool isStoredBack = storeInst->getValueOperand() == gepInst &&
+                          storeInst->getPointerOperand() == loadInst->getPointerOperand();
+      if (isStoredBack) return true;
+    }
+  }
+
+  return false;
+}
+
+/*
+ * The roles are recognized by the structure of the va_arg lowering. If that
+ * does not match (e.g. aligned overflow areas) we fall back to the names that
+ * clang assigns.
+ */
+static VarArgRole
+classifyVarArgRole(const llvm::Instruction* currentInst,
+                   const llvm::Value*& vaArgAddrMemLocationMatr)
+{
+  if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(currentInst)) {
+    const auto gepInstPtr = gepInst->getPointerOperand();
+
+    long vaListField = getLoadedVaListField(gepInstPtr);
+
+    if (vaListField == VA_LIST_REG_SAVE_AREA) return VarArgRole::REG_SAVE_AREA;
+
+    if (vaListField == VA_LIST_OVERFLOW_ARG_AREA &&
+        isStoredToLoadedVaListField(gepInst)) return VarArgRole::OVERFLOW_ARG_AREA_NEXT;
+
+    if (gepInstPtr->getName().contains_lower("reg_save_area")) return VarArgRole::REG_SAVE_AREA;
+
+    if (gepInst->getName().contains_lower("overflow_arg_area.next")) return VarArgRole::OVERFLOW_ARG_AREA_NEXT;
+  }
+  else
+  if (const auto phiNodeInst = llvm::dyn_cast<llvm::PHINode>(currentInst)) {
+    for (const auto& incomingValue : phiNodeInst->incoming_values()) {
+      bool isVaArgAddrInMem = getLoadedVaListField(incomingValue) == VA_LIST_OVERFLOW_ARG_AREA;
+      if (!isVaArgAddrInMem) continue;
+
+      vaArgAddrMemLocationMatr = incomingValue;
+
+      return VarArgRole::VA_ARG_ADDR;
+    }
+
+    bool isVarArgAddr = phiNodeInst->getName().contains_lower("vaarg.addr");
+    if (!isVarArgAddr) return VarArgRole::NONE;
+
+    for (const auto& block : phiNodeInst->blocks()) {
+      bool isVarArgInMem = block->getName().contains_lower("vaarg.in_mem");
+      if (!isVarArgInMem) continue;
+
+      vaArgAddrMemLocationMatr = phiNodeInst->getIncomingValueForBlock(block);
+
+      return VarArgRole::VA_ARG_ADDR;
+    }
+  }
+
+  return VarArgRole::NONE;
+}
+
+/*
+ * A function uses a va_list if it accesses a field of one. This is the case
+ * for every lowered va_arg.
+ */
+static bool
+isVaListFunction(const llvm::Function* function)
+{
+  for (const auto& basicBlock : *function) {
+    for (const auto& instruction : basicBlock) {
+      if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(&instruction)) {
+        bool isVaListFieldAccess = DataFlowUtils::isVaListType(gepInst->getSourceElementType());
+        if (isVaListFieldAccess) return true;
+      }
+    }
   }
 
   return false;
 }
 
+/*
+ * Vararg roles are classified once per function. Functions that do not use a
+ * va_list are not classified at all.
+ */
+static bool
+classifyVarArgRoles(const llvm::Function* function)
+{
+  const ValueId functionId = valueNumbering.getId(function);
+
+  const auto vaListFunction = vaListFunctionTable.find(functionId);
+  if (vaListFunction) return *vaListFunction;
+
+  bool isVaListFunc = isVaListFunction(function);
+  vaListFunctionTable.insert(functionId, isVaListFunc);
+
+  if (!isVaListFunc) return false;
+
+  for (const auto& basicBlock : *function) {
+    for (const auto& instruction : basicBlock) {
+      const llvm::Value* vaArgAddrMemLocationMatr = nullptr;
+
+      const auto varArgRole = classifyVarArgRole(&instruction, vaArgAddrMemLocationMatr);
+      if (varArgRole == VarArgRole::NONE) continue;
+
+      const ValueId instructionId = valueNumbering.getId(&instruction);
+
+      varArgRoleTable.insert(instructionId, varArgRole);
+      if (vaArgAddrMemLocationMatr) vaArgAddrMemLocationMatrTable.insert(instructionId, vaArgAddrMemLocationMatr);
+    }
+  }
+
+  return true;
+}
+
+VarArgRole
+DataFlowUtils::getVarArgRole(const llvm::Instruction* currentInst)
+{
+  bool hasFunction = currentInst->getParent();
+  if (!hasFunction) return VarArgRole::NONE;
+
+  bool isVaListFunc = classifyVarArgRoles(currentInst->getFunction());
+  if (!isVaListFunc) return VarArgRole::NONE;
+
+  const auto varArgRole = varArgRoleTable.find(valueNumbering.getId(currentInst));
+  if (!varArgRole) return VarArgRole::NONE;
+
+  return *varArgRole;
+}
+
 /*
  * We use the following conditions to check whether a memory location is an array decay
  * or not:
@@ -866,13 +1770,13 @@ DataFlowUtils::isReturnValue(const llvm::Instruction* currentInst,
  * Check 071-arrays-3, 071-arrays-11, 200-map-to-callee-variable-array-2,
  * 200-map-to-callee-varargs-30, 260-globals-12
  */
-bool
-DataFlowUtils::isArrayDecay(const llvm::Value* memLocationMatr)
+static bool
+isArrayDecayRec(const llvm::Value* memLocationMatr)
 {
   if (!memLocationMatr) return false;
 
   if (const auto constExpr = llvm::dyn_cast<llvm::ConstantExpr>(memLocationMatr)) {
-    memLocationMatr = const_cast<llvm::ConstantExpr*>(constExpr)->getAsInstruction();
+    memLocationMatr = detachedInstructionTable.getAsInstruction(constExpr);
   }
 
   bool isMemLocationFrame = isMemoryLocationFrame(memLocationMatr);
@@ -881,7 +1785,7 @@ DataFlowUtils::isArrayDecay(const llvm::Value* memLocationMatr)
   }
   else
   if (const auto castInst = llvm::dyn_cast<llvm::CastInst>(memLocationMatr)) {
-    return isArrayDecay(castInst->getOperand(0));
+    return isArrayDecayRec(castInst->getOperand(0));
   }
   else
   if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationMatr)) {
@@ -899,7 +1803,110 @@ DataFlowUtils::isArrayDecay(const llvm::Value* memLocationMatr)
 }
 
 bool
-DataFlowUtils::isGlobalMemoryLocationSeq(const std::vector<const llvm::Value*> memLocationSeq)
+DataFlowUtils::isArrayDecay(const llvm::Value* memLocationMatr)
+{
+  if (!memLocationMatr) return false;
+
+  const ValueId memLocationMatrId = valueNumbering.getId(memLocationMatr);
+
+  const auto arrayDecay = arrayDecayTable.find(memLocationMatrId);
+  if (arrayDecay) {
+    ++arrayDecayCacheHits;
+
+    return *arrayDecay;
+  }
+
+  ++arrayDecayCacheMisses;
+
+  bool isArrayDecay = isArrayDecayRec(memLocationMatr);
+  arrayDecayTable.insert(memLocationMatrId, isArrayDecay);
+
+  return isArrayDecay;
+}
+
+static const llvm::Function*
+getFunctionOfMemoryLocationFrame(const llvm::Value* memLocationFrame)
+{
+  if (const auto inst = llvm::dyn_cast<llvm::Instruction>(memLocationFrame)) {
+    return inst->getParent() ? inst->getFunction() : nullptr;
+  }
+  else
+  if (const auto arg = llvm::dyn_cast<llvm::Argument>(memLocationFrame)) {
+    return arg->getParent();
+  }
+
+  return nullptr;
+}
+
+/*
+ * Recursive data structures and long pointer chains lead to ever growing
+ * memory location sequences where each length is a new fact. We therefore
+ * cut created sequences after the first k parts and append the summary part
+ * which stands for all the cut off parts. A limited fact still taints every
+ * memory location below its first k parts but it is only killed by a store to
+ * one of them (see isKilledMemoryLocationSeq()). Parts after a summary part
+ * (e.g. from joining a limited fact) are subsumed by it and dropped.
+ *
+ * In adaptive mode k is lowered by one for a function (identified by the
+ * frame of the sequence) every time it has created another threshold many
+ * distinct sequences. It is never lowered below 2 (frame and one part). With
+ * no global limit the first limit of a function is the longest sequence it
+ * has created so far. Adaptive limits depend on the order in which the solver
+ * visits facts so memoization is disabled in that mode (see
+ * getComputeTargetsMemoSize()).
+ */
+void
+DataFlowUtils::limitMemoryLocationSeq(std::vector<const llvm::Value*>& memLocationSeq)
+{
+  static const unsigned long MIN_LIMIT = 2;
+
+  if (memLocationSeq.empty()) return;
+
+  std::size_t numConcreteParts = getNumConcreteMemoryLocationParts(memLocationSeq);
+
+  bool isLimitedSeq = numConcreteParts < memLocationSeq.size();
+  if (isLimitedSeq) memLocationSeq.resize(numConcreteParts + 1);
+
+  unsigned long limit = getMemoryLocationSeqLimit();
+
+  unsigned long threshold = getAdaptiveSeqLimitThreshold();
+  if (threshold > 0) {
+    const auto function = getFunctionOfMemoryLocationFrame(memLocationSeq.front());
+
+    auto& memLocationSeqLimit = memLocationSeqLimits.insert({ function, { limit, 0, {} } }).first->second;
+
+    memLocationSeqLimit.maxNumConcreteParts = std::max(memLocationSeqLimit.maxNumConcreteParts, numConcreteParts);
+    memLocationSeqLimit.createdSeqHashes.insert(llvm::hash_combine_range(memLocationSeq.begin(),
+                                                                         memLocationSeq.end()));
+
+    if (memLocationSeqLimit.createdSeqHashes.size() >= threshold) {
+      unsigned long currentLimit = memLocationSeqLimit.limit > 0 ? memLocationSeqLimit.limit :
+                                                                   memLocationSeqLimit.maxNumConcreteParts;
+
+      memLocationSeqLimit.limit = std::max(MIN_LIMIT, currentLimit - 1);
+      memLocationSeqLimit.createdSeqHashes.clear();
+
+      LOG_DEBUG("Lowered memory location sequence limit of "
+                << (function ? function->getName().str() : "<globals>")
+                << " to " << memLocationSeqLimit.limit);
+    }
+
+    limit = memLocationSeqLimit.limit;
+  }
+
+  bool isLimited = limit > 0 && numConcreteParts > std::max(MIN_LIMIT, limit);
+  if (!isLimited) return;
+
+  const auto summaryPart = getSummaryMemoryLocationPart(memLocationSeq.front());
+
+  memLocationSeq.resize(std::max(MIN_LIMIT, limit));
+  memLocationSeq.push_back(summaryPart);
+
+  ++limitedMemLocationSeqs;
+}
+
+bool
+DataFlowUtils::isGlobalMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeq)
 {
   if (memLocationSeq.empty()) return false;
 
@@ -907,10 +1914,15 @@ DataFlowUtils::isGlobalMemoryLocationSeq(const std::vector<const llvm::Value*> m
 }
 
 static void
-dumpMemoryLocation(const std::vector<const llvm::Value*> memLocationSeq)
+dumpMemoryLocation(llvm::ArrayRef<const llvm::Value*> memLocationSeq)
 {
 #ifdef DEBUG_BUILD
   for (const auto memLocationPart : memLocationSeq) {
+    if (isSummaryMemoryLocationPart(memLocationPart)) {
+      llvm::outs() << "[ENV_TRACE] <summary>\n";
+      continue;
+    }
+
     llvm::outs() << "[ENV_TRACE] "; memLocationPart->print(llvm::outs()); llvm::outs() << "\n";
     llvm::outs().flush();
   }
@@ -925,8 +1937,8 @@ DataFlowUtils::dumpFact(const ExtendedValue& ev)
     dumpMemoryLocation(ev.getMemLocationSeq());
   }
 
-  if (!ev.getEndOfTaintedBlockLabel().empty()) {
-    LOG_DEBUG("endOfTaintedBlockLabel: " << ev.getEndOfTaintedBlockLabel());
+  if (const auto endBasicBlock = getEndOfTaintedBlockFromFact(ev)) {
+    LOG_DEBUG("endOfTaintedBlockLabel: " << endBasicBlock->getName());
   }
 
   if (ev.isVarArg()) {
@@ -934,7 +1946,16 @@ DataFlowUtils::dumpFact(const ExtendedValue& ev)
       LOG_DEBUG("vaListMemLocationSeq:");
       dumpMemoryLocation(getVaListMemoryLocationSeqFromFact(ev));
     }
-    LOG_DEBUG("varArgIndex: " << ev.getVarArgIndex());
+    if (isVarArgIndexSet(ev.getVarArgIndex())) {
+      std::stringstream varArgIndices;
+      for (long i = 0; i < MAX_VAR_ARG_SET_INDEX; ++i) {
+        if (isVarArgIndexTainted(ev, i)) varArgIndices << i << " ";
+      }
+      LOG_DEBUG("varArgIndices: " << varArgIndices.str());
+    }
+    else {
+      LOG_DEBUG("varArgIndex: " << ev.getVarArgIndex());
+    }
     LOG_DEBUG("currentVarArgIndex: " << ev.getCurrentVarArgIndex());
   }
 }
@@ -997,6 +2018,261 @@ DataFlowUtils::getBlacklistedFunctions()
   return blacklistedFunctions;
 }
 
+/*
+ * Runs on the thread pool. We must not use DebugLoc::getFnDebugLoc() here as
+ * it creates (and uniques) a DILocation in the shared context. The subprogram
+ * is the scope of that location so we read it directly.
+ */
+static const DebugLocation
+computeDebugLocation(const llvm::Instruction* instruction)
+{
+  DebugLocation debugLocation = { false, "", "", 0 };
+
+  const auto location = instruction->getDebugLoc().get();
+  if (!location) return debugLocation;
+
+  const auto subprogram = location->getInlinedAtScope()->getSubprogram();
+  if (!subprogram) return debugLocation;
+
+  const auto function = instruction->getFunction();
+  if (!function) return debugLocation;
+
+  debugLocation.isValid = true;
+  debugLocation.file = subprogram->getDirectory().str() +
+                       "/" +
+                       subprogram->getFilename().str();
+  debugLocation.functionName = function->getName().str();
+  debugLocation.lineNumber = location->getLine();
+
+  return debugLocation;
+}
+
+const DebugLocation&
+DataFlowUtils::getDebugLocation(const llvm::Instruction* instruction)
+{
+  const auto debugLocationEntry = debugLocationCache.find(instruction);
+  if (debugLocationEntry != debugLocationCache.end()) return debugLocationEntry->second;
+
+  return debugLocationCache.insert({ instruction, computeDebugLocation(instruction) }).first->second;
+}
+
+void
+DataFlowUtils::classifyTypes(const llvm::Module& module)
+{
+  typeClassificationTable.classify(module);
+}
+
+void
+DataFlowUtils::numberValues(const llvm::Module& module)
+{
+  valueNumbering.number(module);
+}
+
+using DebugLocations = std::vector<std::pair<const llvm::Instruction*, const DebugLocation>>;
+
+struct MemoryLocation
+{
+  const llvm::Value* memLocationMatr;
+  std::vector<const llvm::Value*> memLocationSeq;
+  bool isArrayDecay;
+};
+
+using MemoryLocations = std::vector<MemoryLocation>;
+
+struct FunctionPrecomputation
+{
+  EndOfTaintedBlocks endOfTaintedBlocks;
+  FlowKinds flowKinds;
+  DebugLocations debugLocations;
+  MemoryLocations memLocations;
+  std::vector<const llvm::Value*> globalMemLocationMatrs;
+};
+
+static bool
+isPointerOperand(const llvm::Value* operand)
+{
+  return operand->getType()->isPointerTy() &&
+         !llvm::isa<llvm::Function>(operand);
+}
+
+/*
+ * Must only read the IR and the classified types as it is run for all
+ * functions in parallel. Memory locations that cannot be walked read-only are
+ * deferred to the serial part.
+ */
+static void
+precomputeFunction(const llvm::Function* function,
+                   FunctionPrecomputation& functionPrecomputation)
+{
+  functionPrecomputation.endOfTaintedBlocks = computeEndOfTaintedBlocks(function);
+  functionPrecomputation.flowKinds = classifyFlowKinds(function);
+
+  std::set<const llvm::Value*> memLocationMatrs;
+
+  for (const auto& basicBlock : *function) {
+    for (const auto& instruction : basicBlock) {
+      functionPrecomputation.debugLocations.push_back({ &instruction, computeDebugLocation(&instruction) });
+
+      for (const auto& operand : instruction.operands()) {
+        if (!isPointerOperand(operand)) continue;
+
+        bool isNewMemLocationMatr = memLocationMatrs.insert(operand).second;
+        if (!isNewMemLocationMatr) continue;
+
+        bool isReadOnlyMemLocationMatr = isReadOnlyMemoryLocationMatr(operand);
+        if (!isReadOnlyMemLocationMatr) {
+          functionPrecomputation.globalMemLocationMatrs.push_back(operand);
+          continue;
+        }
+
+        functionPrecomputation.memLocations.push_back({ operand,
+                                                        normalizeMemoryLocationSeq(getMemoryLocationSeqFromMatrRec(operand)),
+                                                        isArrayDecayRec(operand) });
+      }
+    }
+  }
+}
+
+static void
+storeMemoryLocations(const MemoryLocations& memLocations)
+{
+  for (const auto& memLocation : memLocations) {
+    auto memLocationSeq = memLocation.memLocationSeq;
+    if (DataFlowUtils::isReduceFactSets()) canonicalizeMemoryLocationSeq(memLocationSeq);
+
+    const auto memLocationSeqEntry = memLocationSeqCache.insert({ memLocation.memLocationMatr, memLocationSeq });
+
+    bool isNewMemLocationSeq = memLocationSeqEntry.second;
+    if (isNewMemLocationSeq) {
+      internMemoryLocationSeq(memLocationSeqEntry.first->second);
+      ++memLocationSeqCacheMisses;
+    }
+
+    const ValueId memLocationMatrId = valueNumbering.getId(memLocation.memLocationMatr);
+
+    bool isNewArrayDecay = !arrayDecayTable.find(memLocationMatrId);
+    if (isNewArrayDecay) {
+      arrayDecayTable.insert(memLocationMatrId, memLocation.isArrayDecay);
+      ++arrayDecayCacheMisses;
+    }
+  }
+}
+
+/*
+ * Fill the caches for the given functions before the solver starts. Post
+ * dominator trees, flow kinds, debug locations and the memory locations of
+ * all pointer operands that do not involve globals are computed for every
+ * function on a thread pool. Each task only reads the IR and writes into its
+ * own slot. Memory locations of globals are materialized afterwards on a
+ * single thread as this creates detached instructions (which modifies the use
+ * lists of constants).
+ *
+ * Everything not covered here is still computed lazily on first use.
+ */
+void
+DataFlowUtils::precompute(const std::vector<const llvm::Function*>& functions)
+{
+  std::vector<FunctionPrecomputation> functionPrecomputations(functions.size());
+
+  {
+    llvm::ThreadPool threadPool;
+
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+      threadPool.async([&functions, &functionPrecomputations, i]() {
+        precomputeFunction(functions[i], functionPrecomputations[i]);
+      });
+    }
+
+    threadPool.wait();
+  }
+
+  for (std::size_t i = 0; i < functions.size(); ++i) {
+    const auto& functionPrecomputation = functionPrecomputations[i];
+
+    storeEndOfTaintedBlocks(functions[i], functionPrecomputation.endOfTaintedBlocks);
+    storeFlowKinds(functionPrecomputation.flowKinds);
+    classifyVarArgRoles(functions[i]);
+
+    for (const auto& debugLocation : functionPrecomputation.debugLocations) {
+      debugLocationCache.insert(debugLocation);
+    }
+
+    storeMemoryLocations(functionPrecomputation.memLocations);
+
+    for (const auto globalMemLocationMatr : functionPrecomputation.globalMemLocationMatrs) {
+      DataFlowUtils::getMemoryLocationSeqFromMatr(globalMemLocationMatr);
+      DataFlowUtils::isArrayDecay(globalMemLocationMatr);
+    }
+  }
+
+  LOG_INFO("Precomputed functions: " << functions.size());
+}
+
+void
+DataFlowUtils::logCacheStats()
+{
+  LOG_INFO("Memory location sequence cache: " << memLocationSeqCacheHits << " hits, "
+                                              << memLocationSeqCacheMisses << " misses");
+  LOG_INFO("Array decay cache: " << arrayDecayCacheHits << " hits, "
+                                 << arrayDecayCacheMisses << " misses");
+  LOG_INFO("Memory location sequence trie: " << memLocationSeqTrie.size() << " nodes");
+  LOG_INFO("GEP part descriptors: " << gepPartDescriptorCache.size());
+  if (isReduceFactSets()) LOG_INFO("Canonicalized GEP parts: " << canonicalizedGEPParts);
+  LOG_INFO("Classified types: " << typeClassificationTable.size());
+  LOG_INFO("Sanitized call edges: " << sanitizedArgListCache.size());
+  LOG_INFO("Post dominated functions: " << postDominatedFunctionTable.size());
+  LOG_INFO("Classified instructions: " << flowKindTable.size());
+  LOG_INFO("Debug locations: " << debugLocationCache.size());
+  LOG_INFO("Vararg roles: " << varArgRoleTable.size());
+  LOG_INFO("Numbered values: " << valueNumbering.size());
+  LOG_INFO("Limited memory location sequences: " << limitedMemLocationSeqs);
+  for (const auto& memLocationSeqLimit : memLocationSeqLimits) {
+    bool isWidened = memLocationSeqLimit.second.limit != getMemoryLocationSeqLimit();
+    if (!isWidened) continue;
+
+    const auto function = memLocationSeqLimit.first;
+    LOG_INFO("Widened " << (function ? function->getName().str() : "<globals>")
+                        << ": limit " << memLocationSeqLimit.second.limit << ", longest sequence "
+                        << memLocationSeqLimit.second.maxNumConcreteParts << " parts");
+  }
+  LOG_INFO("Detached instructions (materialized constant expressions and split GEPs): " << detachedInstructionTable.size());
+}
+
+void
+DataFlowUtils::clearCaches()
+{
+  memLocationSeqCache.clear();
+  arrayDecayTable.clear();
+  memLocationSeqTrie.clear();
+  memLocationSeqNodes.clear();
+  memLocationSeqLimits.clear();
+  gepPartDescriptorCache.clear();
+  gepIndexPathIds.clear();
+  canonicalGEPParts.clear();
+  typeClassificationTable.clear();
+  sanitizedArgListCache.clear();
+  endOfTaintedBlockTable.clear();
+  endOfTaintedBlockLabels.clear();
+  endOfTaintedBlocksByLabel.clear();
+  postDominatedFunctionTable.clear();
+  flowKindTable.clear();
+  debugLocationCache.clear();
+  vaListFunctionTable.clear();
+  varArgRoleTable.clear();
+  vaArgAddrMemLocationMatrTable.clear();
+  valueNumbering.clear();
+
+  // Free detached instructions after all caches referring to them are gone
+  detachedInstructionTable.clear();
+
+  memLocationSeqCacheHits = 0;
+  memLocationSeqCacheMisses = 0;
+  arrayDecayCacheHits = 0;
+  arrayDecayCacheMisses = 0;
+  limitedMemLocationSeqs = 0;
+  canonicalizedGEPParts = 0;
+}
+
 const std::string
 DataFlowUtils::getTraceFilenamePrefix(std::string entryPoint)
 {
@@ -5,17 +5,76 @@
 #ifndef DATAFLOWUTILS_H
 #define DATAFLOWUTILS_H
 
+#include <cstddef>
 #include <string>
 #include <set>
-#include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#include <llvm/ADT/ArrayRef.h>
+
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
 
 #include <phasar/PhasarLLVM/Domain/ExtendedValue.h>
 
 namespace psr {
 
+struct SanitizedArg
+{
+  const llvm::Value* arg;
+  llvm::ArrayRef<const llvm::Value*> argMemLocationSeq;
+  const llvm::Value* param;
+  long varArgIndex; // -1 if param is not a var arg
+};
+
+/*
+ * Sanitized arguments of a call edge. As we only need to consider args that
+ * could match a fact the args are also indexed by their memory location frame
+ * (memory location args) and by value (all other args).
+ */
+struct SanitizedArgList
+{
+  std::vector<SanitizedArg> args;
+  std::unordered_map<const llvm::Value*, std::vector<std::size_t>> memLocationFrameArgIndices;
+  std::unordered_map<const llvm::Value*, std::vector<std::size_t>> valueArgIndices;
+};
+
+/*
+ * Source location of an instruction as it is written to the traces.
+ */
+struct DebugLocation
+{
+  bool isValid;
+  std::string file;
+  std::string functionName;
+  unsigned int lineNumber;
+};
+
+/*
+ * Flow function that is responsible for an instruction on normal edges.
+ */
+enum class FlowKind
+{
+  STORE,
+  BRANCH_SWITCH,
+  GEP,
+  PHI_NODE,
+  CHECK_OPERANDS,
+  IDENTITY
+};
+
+/*
+ * Role of an instruction in the lowering of va_arg (x86-64).
+ */
+enum class VarArgRole
+{
+  NONE,
+  REG_SAVE_AREA,          // gep on the loaded reg_save_area
+  OVERFLOW_ARG_AREA_NEXT, // gep advancing overflow_arg_area to the next vararg
+  VA_ARG_ADDR             // phi joining the address of the vararg
+};
+
 class DataFlowUtils
 {
 public:
@@ -26,57 +85,75 @@ public:
 
   static bool isMemoryLocationTainted(const llvm::Value* memLocationMatr,
                                       const ExtendedValue& fact);
+  static bool isMemoryLocationKilled(const llvm::Value* memLocationMatr,
+                                     const ExtendedValue& fact);
 
-  static const std::vector<const llvm::Value*> getMemoryLocationSeqFromMatr(const llvm::Value* memLocationMatr);
+  static const std::vector<const llvm::Value*>& getMemoryLocationSeqFromMatr(const llvm::Value* memLocationMatr);
   static const std::vector<const llvm::Value*> getMemoryLocationSeqFromFact(const ExtendedValue& memLocationFact);
   static const std::vector<const llvm::Value*> getVaListMemoryLocationSeqFromFact(const ExtendedValue& vaListFact);
 
-  static bool isMemoryLocationSeqsEqual(const std::vector<const llvm::Value*> memLocationSeq1,
-                                        const std::vector<const llvm::Value*> memLocationSeq2);
+  static bool isMemoryLocationSeqsEqual(llvm::ArrayRef<const llvm::Value*> memLocationSeq1,
+                                        llvm::ArrayRef<const llvm::Value*> memLocationSeq2);
 
-  static bool isSubsetMemoryLocationSeq(const std::vector<const llvm::Value*> memLocationSeqInst,
-                                        const std::vector<const llvm::Value*> memLocationSeqFact);
-  static const std::vector<const llvm::Value*> getRelocatableMemoryLocationSeq(const std::vector<const llvm::Value*> taintedMemLocationSeq,
-                                                                               const std::vector<const llvm::Value*> srcMemLocationSeq);
-  static const std::vector<const llvm::Value*> joinMemoryLocationSeqs(const std::vector<const llvm::Value*> memLocationSeq1,
-                                                                      const std::vector<const llvm::Value*> memLocationSeq2);
+  static bool isSubsetMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeqInst,
+                                        llvm::ArrayRef<const llvm::Value*> memLocationSeqFact);
+  static bool isKilledMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeqInst,
+                                        llvm::ArrayRef<const llvm::Value*> memLocationSeqFact);
+  static llvm::ArrayRef<const llvm::Value*> getRelocatableMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> taintedMemLocationSeq,
+                                                                            llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq);
+  static void limitMemoryLocationSeq(std::vector<const llvm::Value*>& memLocationSeq);
+  static const std::vector<const llvm::Value*> joinMemoryLocationSeqs(llvm::ArrayRef<const llvm::Value*> memLocationSeq1,
+                                                                      llvm::ArrayRef<const llvm::Value*> memLocationSeq2);
 
   static bool isPatchableArgumentStore(const llvm::Value* srcValue,
                                        const ExtendedValue& fact);
   static bool isPatchableArgumentMemcpy(const llvm::Value* srcValue,
-                                        const std::vector<const llvm::Value*> srcMemLocationSeq,
+                                        llvm::ArrayRef<const llvm::Value*> srcMemLocationSeq,
                                         const ExtendedValue& fact);
   static bool isPatchableVaListArgument(const llvm::Value* srcValue,
                                         const ExtendedValue& fact);
   static bool isPatchableReturnValue(const llvm::Value* srcValue,
                                      const ExtendedValue& fact);
-  static const std::vector<const llvm::Value*> patchMemoryLocationFrame(const std::vector<const llvm::Value*> patchableMemLocationSeq,
-                                                                        const std::vector<const llvm::Value*> patchMemLocationSeq);
+  static const std::vector<const llvm::Value*> patchMemoryLocationFrame(llvm::ArrayRef<const llvm::Value*> patchableMemLocationSeq,
+                                                                        llvm::ArrayRef<const llvm::Value*> patchMemLocationSeq);
 
-  static const std::vector<std::tuple<const llvm::Value*,
-                           const std::vector<const llvm::Value*>,
-                           const llvm::Value*>>
-              getSanitizedArgList(const llvm::CallInst* callInst,
-                                  const llvm::Function* destMthd,
-                                  const llvm::Value* zeroValue);
+  static const SanitizedArgList& getSanitizedArgList(const llvm::CallInst* callInst,
+                                                     const llvm::Function* destMthd,
+                                                     const llvm::Value* zeroValue);
 
   static const llvm::BasicBlock* getEndOfTaintedBlock(const llvm::BasicBlock* startBasicBlock);
+  static const std::string getEndOfTaintedBlockLabel(const llvm::BasicBlock* endBasicBlock);
+  static const llvm::BasicBlock* getEndOfTaintedBlockFromFact(const ExtendedValue& fact);
   static bool removeTaintedBlockInst(const ExtendedValue& fact,
                                      const llvm::Instruction* currentInst);
   static bool isAutoGENInTaintedBlock(const llvm::Instruction* currentInst);
+  static bool isCompactTaintedBlocks();
+  static bool isReduceFactSets();
+  static unsigned long getComputeTargetsMemoSize();
+  static unsigned long getMemoryLocationSeqLimit();
+  static unsigned long getAdaptiveSeqLimitThreshold();
+  static bool isEscapingValue(const llvm::Instruction* currentInst);
 
   static bool isMemoryLocationFact(const ExtendedValue& ev);
   static bool isKillAfterStoreFact(const ExtendedValue& ev);
   static bool isCheckOperandsInst(const llvm::Instruction* currentInst);
+  static FlowKind getFlowKind(const llvm::Instruction* currentInst);
   static bool isAutoIdentity(const llvm::Instruction* currentInst,
                              const ExtendedValue& fact);
   static bool isVarArgParam(const llvm::Value* param,
                             const llvm::Value* zeroValue);
+  static bool isVarArgIndexTainted(const ExtendedValue& fact,
+                                   long varArgIndex);
+  static long joinVarArgIndices(long varArgIndex1,
+                                long varArgIndex2);
+  static long removeVarArgIndex(long varArgIndex,
+                                long removedVarArgIndex);
+  static const std::set<ExtendedValue> getRemainingVarArgFacts(const ExtendedValue& patchedFact);
+  static void compressVarArgFacts(std::set<ExtendedValue>& facts);
   static bool isVaListType(const llvm::Type* type);
-  static bool isReturnValue(const llvm::Instruction* currentInst,
-                            const llvm::Instruction* successorInst);
+  static VarArgRole getVarArgRole(const llvm::Instruction* currentInst);
   static bool isArrayDecay(const llvm::Value* memLocationMatr);
-  static bool isGlobalMemoryLocationSeq(const std::vector<const llvm::Value*> memLocationSeq);
+  static bool isGlobalMemoryLocationSeq(llvm::ArrayRef<const llvm::Value*> memLocationSeq);
 
   static void dumpFact(const ExtendedValue& ev);
 
@@ -84,6 +161,15 @@ public:
   static const std::set<std::string> getBlacklistedFunctions();
 
   static const std::string getTraceFilenamePrefix(std::string entryPoint);
+
+  static const DebugLocation& getDebugLocation(const llvm::Instruction* instruction);
+
+  static void classifyTypes(const llvm::Module& module);
+  static void numberValues(const llvm::Module& module);
+  static void precompute(const std::vector<const llvm::Function*>& functions);
+
+  static void logCacheStats();
+  static void clearCaches();
 };
 
 } // namespace
@@ -0,0 +1,67 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "DetachedInstructionTable.h"
+
+#include <string>
+
+#include <llvm/IR/Instructions.h>
+
+namespace psr {
+
+const llvm::Instruction*
+DetachedInstructionTable::getAsInstruction(const llvm::ConstantExpr* constExpr)
+{
+  const auto constExprInstructionEntry = constExprInstructions.find(constExpr);
+  if (constExprInstructionEntry != constExprInstructions.end()) return constExprInstructionEntry->second;
+
+  const auto instruction = const_cast<llvm::ConstantExpr*>(constExpr)->getAsInstruction();
+  instructions.push_back(instruction);
+
+  constExprInstructions.insert({ constExpr, instruction });
+
+  return instruction;
+}
+
+const llvm::Instruction*
+DetachedInstructionTable::getSplitGEP(const llvm::Value* base,
+                                      llvm::Value* firstIndex,
+                                      llvm::Value* secondIndex,
+                                      unsigned int splitNo)
+{
+  const SplitGEPKey splitGEPKey(base, firstIndex, secondIndex);
+
+  const auto splitGEPEntry = splitGEPs.find(splitGEPKey);
+  if (splitGEPEntry != splitGEPs.end()) return splitGEPEntry->second;
+
+  const auto splitGEPInst = llvm::GetElementPtrInst::CreateInBounds(const_cast<llvm::Value*>(base),
+                                                                    { firstIndex, secondIndex },
+                                                                    "gepsplit" + std::to_string(splitNo));
+  instructions.push_back(splitGEPInst);
+
+  splitGEPs.insert({ splitGEPKey, splitGEPInst });
+
+  return splitGEPInst;
+}
+
+void
+DetachedInstructionTable::clear()
+{
+  /*
+   * Detached instructions may use each other so drop all uses before
+   * deleting any of them.
+   */
+  for (const auto instruction : instructions) {
+    instruction->dropAllReferences();
+  }
+  for (const auto instruction : instructions) {
+    instruction->deleteValue();
+  }
+
+  instructions.clear();
+  constExprInstructions.clear();
+  splitGEPs.clear();
+}
+
+} // namespace
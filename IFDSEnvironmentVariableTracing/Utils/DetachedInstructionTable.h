@@ -0,0 +1,64 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef DETACHEDINSTRUCTIONTABLE_H
+#define DETACHEDINSTRUCTIONTABLE_H
+
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instruction.h>
+
+namespace psr {
+
+/*
+ * Owns instructions that are not part of the module but are used as memory
+ * location parts. Global accesses are constant expressions and are turned into
+ * instructions so that we can walk them like any other memory location. Every
+ * constant expression is materialized exactly once which keeps the memory
+ * footprint flat and the resulting pointers stable.
+ *
+ * The same holds for the GEPs created when splitting global GEPs with more
+ * than two indices: a split GEP is identified by its base and its two indices
+ * so equal global paths always yield the same instructions.
+ *
+ * The instructions must be freed (clear()) while the module is still alive
+ * as they are registered as users of its constants.
+ */
+class DetachedInstructionTable
+{
+public:
+  DetachedInstructionTable() = default;
+  ~DetachedInstructionTable() = default;
+
+  DetachedInstructionTable(const DetachedInstructionTable&) = delete;
+  DetachedInstructionTable& operator=(const DetachedInstructionTable&) = delete;
+
+  const llvm::Instruction* getAsInstruction(const llvm::ConstantExpr* constExpr);
+  const llvm::Instruction* getSplitGEP(const llvm::Value* base,
+                                       llvm::Value* firstIndex,
+                                       llvm::Value* secondIndex,
+                                       unsigned int splitNo);
+
+  std::size_t size() const
+  {
+    return instructions.size();
+  }
+  void clear();
+
+private:
+  using SplitGEPKey = std::tuple<const llvm::Value*, const llvm::Value*, const llvm::Value*>;
+
+  std::unordered_map<const llvm::ConstantExpr*, const llvm::Instruction*> constExprInstructions;
+  std::map<SplitGEPKey, const llvm::Instruction*> splitGEPs;
+  std::vector<llvm::Instruction*> instructions;
+};
+
+} // namespace
+
+#endif // DETACHEDINSTRUCTIONTABLE_H
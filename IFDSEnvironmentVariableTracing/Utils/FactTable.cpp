@@ -0,0 +1,74 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "FactTable.h"
+
+#include <llvm/ADT/Hashing.h>
+
+namespace psr {
+
+std::size_t
+FactTable::SeqHash::operator()(const std::vector<const llvm::Value*>& seq) const
+{
+  return llvm::hash_combine_range(seq.begin(), seq.end());
+}
+
+std::size_t
+FactTable::ColdFactHash::operator()(const ColdFact& coldFact) const
+{
+  return llvm::hash_combine(std::get<0>(coldFact),
+                            std::get<1>(coldFact),
+                            std::get<2>(coldFact),
+                            std::get<3>(coldFact));
+}
+
+FactTable::SeqId
+FactTable::internSeq(const std::vector<const llvm::Value*>& seq)
+{
+  const SeqId seqId = static_cast<SeqId>(seqs.size());
+
+  return seqs.insert({ seq, seqId }).first->second;
+}
+
+FactTable::ColdId
+FactTable::internColdFact(const ExtendedValue& fact)
+{
+  const ColdFact coldFact(fact.getEndOfTaintedBlockLabel(),
+                          internSeq(fact.getVaListMemLocationSeq()),
+                          fact.getVarArgIndex(),
+                          fact.getCurrentVarArgIndex());
+
+  const ColdId coldId = static_cast<ColdId>(coldFactIds.size());
+
+  return coldFactIds.insert({ coldFact, coldId }).first->second;
+}
+
+FactId
+FactTable::intern(const ExtendedValue& fact)
+{
+  const HotFact hotFact = { fact.getValue(),
+                            internSeq(fact.getMemLocationSeq()),
+                            internColdFact(fact) };
+
+  const auto factIdEntry = factIds.find(hotFact);
+  if (factIdEntry != factIds.end()) return factIdEntry->second;
+
+  const FactId factId = static_cast<FactId>(facts.size());
+
+  factIds.insert({ hotFact, factId });
+  facts.push_back(fact);
+
+  return factId;
+}
+
+void
+FactTable::clear()
+{
+  seqs.clear();
+  coldFactIds.clear();
+  factIds.clear();
+  facts.clear();
+}
+
+} // namespace
@@ -0,0 +1,116 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef FACTTABLE_H
+#define FACTTABLE_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/IR/Value.h>
+
+#include <phasar/PhasarLLVM/Domain/ExtendedValue.h>
+
+namespace psr {
+
+using FactId = unsigned int;
+
+/*
+ * Intern table for facts. Every distinct fact is stored once and identified
+ * by a 32-bit handle, so plugin side bookkeeping can hash and compare
+ * integers instead of deep comparing ExtendedValues.
+ *
+ * Facts are split into hot fields (value, memory location sequence) that
+ * almost every fact has distinct values for, and cold fields (vararg state,
+ * end of tainted block) that are shared by most facts. Sequences and cold
+ * fields are interned on their own so a fact is keyed by three integers.
+ * Sequences are interned by identity of their parts (no GEP canonicalization)
+ * as handles must be equal iff facts are equal.
+ */
+class FactTable
+{
+public:
+  FactTable() = default;
+  ~FactTable() = default;
+
+  FactId intern(const ExtendedValue& fact);
+
+  const ExtendedValue& getFact(FactId factId) const
+  {
+    return facts[factId];
+  }
+
+  std::size_t size() const
+  {
+    return facts.size();
+  }
+  std::size_t getNumSeqs() const
+  {
+    return seqs.size();
+  }
+  std::size_t getNumColdFacts() const
+  {
+    return coldFactIds.size();
+  }
+  void clear();
+
+private:
+  using SeqId = unsigned int;
+  using ColdId = unsigned int;
+
+  struct HotFact
+  {
+    const llvm::Value* value;
+    SeqId memLocationSeqId;
+    ColdId coldId;
+
+    bool operator==(const HotFact& rhs) const
+    {
+      return value == rhs.value &&
+             memLocationSeqId == rhs.memLocationSeqId &&
+             coldId == rhs.coldId;
+    }
+  };
+
+  struct HotFactHash
+  {
+    std::size_t operator()(const HotFact& hotFact) const
+    {
+      return std::hash<const llvm::Value*>{}(hotFact.value) ^
+             (std::hash<SeqId>{}(hotFact.memLocationSeqId) << 1) ^
+             (std::hash<ColdId>{}(hotFact.coldId) << 2);
+    }
+  };
+
+  struct SeqHash
+  {
+    std::size_t operator()(const std::vector<const llvm::Value*>& seq) const;
+  };
+
+  using ColdFact = std::tuple<std::string, SeqId, long, long>;
+
+  struct ColdFactHash
+  {
+    std::size_t operator()(const ColdFact& coldFact) const;
+  };
+
+  SeqId internSeq(const std::vector<const llvm::Value*>& seq);
+  ColdId internColdFact(const ExtendedValue& fact);
+
+  std::unordered_map<std::vector<const llvm::Value*>, SeqId, SeqHash> seqs;
+  std::unordered_map<ColdFact, ColdId, ColdFactHash> coldFactIds;
+  std::unordered_map<HotFact, FactId, HotFactHash> factIds;
+
+  // Deque keeps references returned by getFact() valid
+  std::deque<ExtendedValue> facts;
+};
+
+} // namespace
+
+#endif // FACTTABLE_H
@@ -0,0 +1,58 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "FunctionFlagsTable.h"
+
+#include <llvm/IR/Intrinsics.h>
+
+namespace psr {
+
+void
+FunctionFlagsTable::classify(const llvm::Module& module)
+{
+  for (const auto& function : module) {
+    getFlags(&function);
+  }
+}
+
+unsigned int
+FunctionFlagsTable::getFlags(const llvm::Function* function)
+{
+  const auto functionFlagsEntry = functionFlags.find(function);
+  if (functionFlagsEntry != functionFlags.end()) return functionFlagsEntry->second;
+
+  const auto functionName = function->getName();
+
+  unsigned int flags = NONE;
+
+  if (blacklistedFunctions.match(functionName)) flags |= BLACKLISTED;
+  if (taintedFunctions.match(functionName)) flags |= TAINTED;
+
+  if (function->isDeclaration()) flags |= DECLARATION;
+  if (function->hasAddressTaken()) flags |= ADDRESS_TAKEN;
+
+  switch (function->getIntrinsicID()) {
+  case llvm::Intrinsic::memcpy:
+  case llvm::Intrinsic::memmove:
+    flags |= MEM_TRANSFER;
+    break;
+  case llvm::Intrinsic::memset:
+    flags |= MEM_SET;
+    break;
+  case llvm::Intrinsic::vastart:
+    flags |= VA_START;
+    break;
+  case llvm::Intrinsic::vaend:
+    flags |= VA_END;
+    break;
+  default:
+    break;
+  }
+
+  functionFlags.insert({ function, flags });
+
+  return flags;
+}
+
+} // namespace
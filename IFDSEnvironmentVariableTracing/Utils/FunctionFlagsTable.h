@@ -0,0 +1,75 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef FUNCTIONFLAGSTABLE_H
+#define FUNCTIONFLAGSTABLE_H
+
+#include "FunctionNameMatcher.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+namespace psr {
+
+/*
+ * Everything we need to know about a function when handling calls to it.
+ * Functions are classified once (by name pattern for tainted and blacklisted
+ * functions) so call handling does not need any string lookups.
+ */
+class FunctionFlagsTable
+{
+public:
+  enum FunctionFlag : unsigned int
+  {
+    NONE = 0,
+    BLACKLISTED = 1 << 0,
+    TAINTED = 1 << 1,
+    DECLARATION = 1 << 2,
+    ADDRESS_TAKEN = 1 << 3,
+    MEM_TRANSFER = 1 << 4,
+    MEM_SET = 1 << 5,
+    VA_START = 1 << 6,
+    VA_END = 1 << 7
+  };
+
+  FunctionFlagsTable(const std::set<std::string>& _taintedFunctions,
+                     const std::set<std::string>& _blacklistedFunctions) :
+    taintedFunctions(_taintedFunctions),
+    blacklistedFunctions(_blacklistedFunctions) { }
+  ~FunctionFlagsTable() = default;
+
+  /*
+   * Classify all functions of the module up front. Functions that are not
+   * covered are classified on first use.
+   */
+  void classify(const llvm::Module& module);
+
+  unsigned int getFlags(const llvm::Function* function);
+
+  bool is(const llvm::Function* function,
+          unsigned int flags)
+  {
+    return getFlags(function) & flags;
+  }
+
+  std::size_t size() const
+  {
+    return functionFlags.size();
+  }
+
+private:
+  const FunctionNameMatcher taintedFunctions;
+  const FunctionNameMatcher blacklistedFunctions;
+
+  std::unordered_map<const llvm::Function*, unsigned int> functionFlags;
+};
+
+} // namespace
+
+#endif // FUNCTIONFLAGSTABLE_H
@@ -0,0 +1,123 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "FunctionNameMatcher.h"
+
+#include "Log.h"
+
+#include <llvm/Support/Error.h>
+
+namespace psr {
+
+static bool
+isWildcard(char c)
+{
+  return c == '*' || c == '?' || c == '[' || c == '\\';
+}
+
+static bool
+hasWildcard(llvm::StringRef pattern)
+{
+  for (const auto c : pattern) {
+    if (isWildcard(c)) return true;
+  }
+
+  return false;
+}
+
+FunctionNameMatcher::FunctionNameMatcher(const std::set<std::string>& patterns)
+{
+  for (const auto& pattern : patterns) {
+    const llvm::StringRef patternRef(pattern);
+
+    bool isExactName = !hasWildcard(patternRef);
+    if (isExactName) {
+      exactNames.insert(pattern);
+      continue;
+    }
+
+    bool isPrefix = patternRef.endswith("*") && !hasWildcard(patternRef.drop_back());
+    if (isPrefix) {
+      prefixes.insert(patternRef.drop_back(), false);
+      continue;
+    }
+
+    bool isSuffix = patternRef.startswith("*") && !hasWildcard(patternRef.drop_front());
+    if (isSuffix) {
+      suffixes.insert(patternRef.drop_front(), true);
+      continue;
+    }
+
+    auto glob = llvm::GlobPattern::create(patternRef);
+    if (!glob) {
+      LOG_INFO("Ignoring invalid pattern: " << pattern);
+      llvm::consumeError(glob.takeError());
+      continue;
+    }
+
+    globs.push_back(std::move(*glob));
+  }
+}
+
+bool
+FunctionNameMatcher::match(llvm::StringRef functionName) const
+{
+  if (exactNames.find(functionName.str()) != exactNames.end()) return true;
+
+  if (prefixes.matchAnyPrefix(functionName, false)) return true;
+  if (suffixes.matchAnyPrefix(functionName, true)) return true;
+
+  for (const auto& glob : globs) {
+    if (glob.match(functionName)) return true;
+  }
+
+  return false;
+}
+
+void
+FunctionNameMatcher::PatternTrie::insert(llvm::StringRef pattern,
+                                         bool isReversed)
+{
+  unsigned int node = 0;
+
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    const char c = isReversed ? pattern[pattern.size() - 1 - i] : pattern[i];
+
+    const auto childEntry = nodes[node].children.find(c);
+    if (childEntry != nodes[node].children.end()) {
+      node = childEntry->second;
+      continue;
+    }
+
+    const unsigned int child = nodes.size();
+    nodes.push_back(Node());
+    nodes[node].children.insert({ c, child });
+
+    node = child;
+  }
+
+  nodes[node].isTerminal = true;
+}
+
+bool
+FunctionNameMatcher::PatternTrie::matchAnyPrefix(llvm::StringRef functionName,
+                                                 bool isReversed) const
+{
+  unsigned int node = 0;
+
+  for (std::size_t i = 0; i < functionName.size(); ++i) {
+    if (nodes[node].isTerminal) return true;
+
+    const char c = isReversed ? functionName[functionName.size() - 1 - i] : functionName[i];
+
+    const auto childEntry = nodes[node].children.find(c);
+    if (childEntry == nodes[node].children.end()) return false;
+
+    node = childEntry->second;
+  }
+
+  return nodes[node].isTerminal;
+}
+
+} // namespace
@@ -0,0 +1,68 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef FUNCTIONNAMEMATCHER_H
+#define FUNCTIONNAMEMATCHER_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <llvm/Support/GlobPattern.h>
+
+namespace psr {
+
+/*
+ * Matches function names against a list of patterns. Supported are exact
+ * names, prefixes (log_*), suffixes (*_debug) and arbitrary globs. Patterns
+ * are compiled once: exact names go into a hash set, prefixes and suffixes
+ * into a trie each and only the remaining globs are checked one by one.
+ */
+class FunctionNameMatcher
+{
+public:
+  FunctionNameMatcher(const std::set<std::string>& patterns);
+  ~FunctionNameMatcher() = default;
+
+  bool match(llvm::StringRef functionName) const;
+
+private:
+  /*
+   * Trie over the characters of the patterns. A node is terminal if a pattern
+   * ends in it.
+   */
+  class PatternTrie
+  {
+  public:
+    PatternTrie() : nodes(1) { }
+    ~PatternTrie() = default;
+
+    void insert(llvm::StringRef pattern,
+                bool isReversed);
+    bool matchAnyPrefix(llvm::StringRef functionName,
+                        bool isReversed) const;
+
+  private:
+    struct Node
+    {
+      std::map<char, unsigned int> children;
+      bool isTerminal = false;
+    };
+
+    std::vector<Node> nodes;
+  };
+
+  std::unordered_set<std::string> exactNames;
+  PatternTrie prefixes;
+  PatternTrie suffixes;
+  std::vector<llvm::GlobPattern> globs;
+};
+
+} // namespace
+
+#endif // FUNCTIONNAMEMATCHER_H
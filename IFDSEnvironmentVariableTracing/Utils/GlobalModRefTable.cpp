@@ -0,0 +1,118 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "GlobalModRefTable.h"
+
+#include <queue>
+#include <set>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+
+namespace psr {
+
+unsigned int
+GlobalModRefTable::getGlobalIndex(const llvm::GlobalVariable* global)
+{
+  const unsigned int globalIndex = static_cast<unsigned int>(globalIndices.size());
+
+  return globalIndices.insert({ global, globalIndex }).first->second;
+}
+
+void
+GlobalModRefTable::collectGlobals(const llvm::Value* value,
+                                  std::vector<unsigned int>& globals)
+{
+  if (const auto global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+    globals.push_back(getGlobalIndex(global));
+  }
+  else
+  if (const auto constExpr = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
+    for (const auto& operand : constExpr->operands()) {
+      collectGlobals(operand, globals);
+    }
+  }
+}
+
+void
+GlobalModRefTable::compute(const std::vector<const llvm::Function*>& functions)
+{
+  const std::set<const llvm::Function*> computedFunctions(functions.begin(), functions.end());
+
+  std::unordered_map<const llvm::Function*, std::vector<unsigned int>> directGlobalRefs;
+  std::unordered_map<const llvm::Function*, std::vector<const llvm::Function*>> callers;
+
+  for (const auto function : functions) {
+    auto& globals = directGlobalRefs[function];
+
+    for (const auto& basicBlock : *function) {
+      for (const auto& instruction : basicBlock) {
+        for (const auto& operand : instruction.operands()) {
+          collectGlobals(operand, globals);
+        }
+
+        const auto callInst = llvm::dyn_cast<llvm::CallInst>(&instruction);
+        if (!callInst) continue;
+
+        const auto calledFunction = callInst->getCalledFunction();
+
+        bool isFollowedCall = calledFunction &&
+                              computedFunctions.find(calledFunction) != computedFunctions.end() &&
+                              !functionFlagsTable.is(calledFunction, FunctionFlagsTable::TAINTED);
+        if (isFollowedCall) callers[calledFunction].push_back(function);
+      }
+    }
+  }
+
+  const unsigned int numGlobals = static_cast<unsigned int>(globalIndices.size());
+
+  std::queue<const llvm::Function*> workList;
+
+  for (const auto& directGlobalRefsEntry : directGlobalRefs) {
+    auto& globalRefsOfFunction = globalRefs[directGlobalRefsEntry.first];
+    globalRefsOfFunction.resize(numGlobals);
+
+    for (const auto globalIndex : directGlobalRefsEntry.second) {
+      globalRefsOfFunction.set(globalIndex);
+    }
+
+    workList.push(directGlobalRefsEntry.first);
+  }
+
+  // Propagate to callers until nothing changes anymore
+  while (!workList.empty()) {
+    const auto function = workList.front();
+    workList.pop();
+
+    const auto callersEntry = callers.find(function);
+    if (callersEntry == callers.end()) continue;
+
+    const auto& globalRefsOfFunction = globalRefs[function];
+
+    for (const auto caller : callersEntry->second) {
+      auto& globalRefsOfCaller = globalRefs[caller];
+
+      const llvm::BitVector previousGlobalRefsOfCaller(globalRefsOfCaller);
+      globalRefsOfCaller |= globalRefsOfFunction;
+
+      bool isChanged = globalRefsOfCaller != previousGlobalRefsOfCaller;
+      if (isChanged) workList.push(caller);
+    }
+  }
+}
+
+bool
+GlobalModRefTable::mayReference(const llvm::Function* function,
+                                const llvm::GlobalVariable* global) const
+{
+  const auto globalRefsEntry = globalRefs.find(function);
+  if (globalRefsEntry == globalRefs.end()) return true;
+
+  const auto globalIndexEntry = globalIndices.find(global);
+  if (globalIndexEntry == globalIndices.end()) return false;
+
+  return globalRefsEntry->second.test(globalIndexEntry->second);
+}
+
+} // namespace
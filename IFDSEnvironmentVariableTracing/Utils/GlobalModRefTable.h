@@ -0,0 +1,67 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef GLOBALMODREFTABLE_H
+#define GLOBALMODREFTABLE_H
+
+#include "FunctionFlagsTable.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/DenseMap.h>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+
+namespace psr {
+
+/*
+ * Globals that a function may read or write, either directly or through one of
+ * the functions it calls. As memory locations are tracked by the syntactic
+ * frame a function can only touch a global fact if the global appears in its
+ * body or in the body of a (transitive) callee. Accesses through pointer
+ * arguments are covered by mapping the arguments.
+ *
+ * Only direct calls are followed as the solver never enters function pointer
+ * calls (see getSummaryFlowFunction()). Functions that have not been computed
+ * may reference every global.
+ */
+class GlobalModRefTable
+{
+public:
+  GlobalModRefTable(FunctionFlagsTable& _functionFlagsTable) :
+    functionFlagsTable(_functionFlagsTable) { }
+  ~GlobalModRefTable() = default;
+
+  void compute(const std::vector<const llvm::Function*>& functions);
+
+  bool mayReference(const llvm::Function* function,
+                    const llvm::GlobalVariable* global) const;
+
+  std::size_t size() const
+  {
+    return globalRefs.size();
+  }
+  std::size_t getNumGlobals() const
+  {
+    return globalIndices.size();
+  }
+
+private:
+  unsigned int getGlobalIndex(const llvm::GlobalVariable* global);
+  void collectGlobals(const llvm::Value* value,
+                      std::vector<unsigned int>& globals);
+
+  FunctionFlagsTable& functionFlagsTable;
+
+  llvm::DenseMap<const llvm::GlobalVariable*, unsigned int> globalIndices;
+  std::unordered_map<const llvm::Function*, llvm::BitVector> globalRefs;
+};
+
+} // namespace
+
+#endif // GLOBALMODREFTABLE_H
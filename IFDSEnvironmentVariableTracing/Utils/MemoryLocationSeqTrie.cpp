@@ -0,0 +1,96 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "MemoryLocationSeqTrie.h"
+
+#include <cassert>
+
+namespace psr {
+
+const llvm::Value*
+MemoryLocationSeqTrie::getCanonicalPart(const llvm::Value* memLocationPart)
+{
+  const auto canonicalPartEntry = canonicalParts.find(memLocationPart);
+  if (canonicalPartEntry != canonicalParts.end()) return canonicalPartEntry->second;
+
+  const llvm::Value* canonicalPart = memLocationPart;
+
+  if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(memLocationPart)) {
+    if (gepInst->hasAllConstantIndices()) {
+      GEPKey gepKey(gepInst->getPointerOperandType(),
+                    std::vector<const llvm::Value*>(gepInst->idx_begin(), gepInst->idx_end()));
+
+      canonicalPart = canonicalGEPs.insert({ gepKey, gepInst }).first->second;
+    }
+  }
+
+  canonicalParts.insert({ memLocationPart, canonicalPart });
+
+  return canonicalPart;
+}
+
+MemoryLocationSeqTrie::NodeId
+MemoryLocationSeqTrie::intern(llvm::ArrayRef<const llvm::Value*> memLocationSeq)
+{
+  NodeId node = ROOT;
+
+  for (const auto memLocationPart : memLocationSeq) {
+    const auto canonicalPart = nodes[node].depth == 0 ? memLocationPart :
+                                                        getCanonicalPart(memLocationPart);
+
+    const ChildKey childKey(node, canonicalPart);
+
+    const auto childEntry = children.find(childKey);
+    if (childEntry != children.end()) {
+      node = childEntry->second;
+      continue;
+    }
+
+    /*
+     * Frames are compared by identity. All other parts must be GEPs with
+     * constant indices in order to be comparable.
+     */
+    bool isConstantPart = nodes[node].depth == 0;
+    if (const auto gepInst = llvm::dyn_cast<llvm::GetElementPtrInst>(canonicalPart)) {
+      isConstantPart = gepInst->hasAllConstantIndices();
+    }
+
+    const NodeId child = static_cast<NodeId>(nodes.size());
+    nodes.push_back({ node,
+                      nodes[node].depth + 1,
+                      canonicalPart,
+                      nodes[node].hasConstantIndices && isConstantPart });
+    children.insert({ childKey, child });
+
+    node = child;
+  }
+
+  return node;
+}
+
+MemoryLocationSeqTrie::NodeId
+MemoryLocationSeqTrie::getAncestor(NodeId node,
+                                   std::size_t depth) const
+{
+  assert(depth <= nodes[node].depth);
+
+  while (nodes[node].depth > depth) {
+    node = nodes[node].parent;
+  }
+
+  return node;
+}
+
+void
+MemoryLocationSeqTrie::clear()
+{
+  nodes.clear();
+  children.clear();
+  canonicalParts.clear();
+  canonicalGEPs.clear();
+
+  nodes.push_back({ ROOT, 0, nullptr, true });
+}
+
+} // namespace
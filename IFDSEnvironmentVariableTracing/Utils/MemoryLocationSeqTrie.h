@@ -0,0 +1,103 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef MEMORYLOCATIONSEQTRIE_H
+#define MEMORYLOCATIONSEQTRIE_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include <llvm/IR/Instructions.h>
+
+namespace psr {
+
+/*
+ * Intern table for memory location sequences. Every distinct sequence is
+ * represented by exactly one node of a trie and identified by a stable id.
+ * Equal sequences share a node and a prefix of a sequence is an ancestor
+ * of its node.
+ *
+ * GEP parts are canonicalized before they are inserted: all GEPs that have
+ * the same pointer operand type and the same constant indices are mapped to
+ * the first of them that has been seen. Non constant GEPs are never equal
+ * to anything (not even to themselves) which is tracked per node.
+ */
+class MemoryLocationSeqTrie
+{
+public:
+  using NodeId = unsigned int;
+
+  static const NodeId ROOT = 0;
+
+  MemoryLocationSeqTrie() { clear(); }
+  ~MemoryLocationSeqTrie() = default;
+
+  NodeId intern(llvm::ArrayRef<const llvm::Value*> memLocationSeq);
+
+  NodeId getAncestor(NodeId node,
+                     std::size_t depth) const;
+
+  NodeId getParent(NodeId node) const
+  {
+    return nodes[node].parent;
+  }
+  std::size_t getDepth(NodeId node) const
+  {
+    return nodes[node].depth;
+  }
+  const llvm::Value* getPart(NodeId node) const
+  {
+    return nodes[node].part;
+  }
+  bool hasConstantIndices(NodeId node) const
+  {
+    return nodes[node].hasConstantIndices;
+  }
+
+  std::size_t size() const
+  {
+    return nodes.size();
+  }
+  void clear();
+
+private:
+  struct Node
+  {
+    NodeId parent;
+    std::size_t depth;
+    const llvm::Value* part;
+    bool hasConstantIndices;
+  };
+
+  using ChildKey = std::pair<NodeId, const llvm::Value*>;
+
+  struct ChildKeyHash
+  {
+    std::size_t operator()(const ChildKey& childKey) const
+    {
+      return std::hash<const llvm::Value*>{}(childKey.second) ^
+             (std::hash<NodeId>{}(childKey.first) << 1);
+    }
+  };
+
+  using GEPKey = std::pair<const llvm::Type*, std::vector<const llvm::Value*>>;
+
+  const llvm::Value* getCanonicalPart(const llvm::Value* memLocationPart);
+
+  std::vector<Node> nodes;
+  std::unordered_map<ChildKey, NodeId, ChildKeyHash> children;
+
+  std::unordered_map<const llvm::Value*, const llvm::Value*> canonicalParts;
+  std::map<GEPKey, const llvm::Value*> canonicalGEPs;
+};
+
+} // namespace
+
+#endif // MEMORYLOCATIONSEQTRIE_H
@@ -0,0 +1,78 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef SIDETABLE_H
+#define SIDETABLE_H
+
+#include "ValueNumbering.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace psr {
+
+/*
+ * Flat table of values indexed by ValueId. Grows on demand, every entry
+ * carries a presence flag so every T can be stored.
+ *
+ * Pointers returned by find() are invalidated by the next insert().
+ */
+template<typename T>
+class SideTable
+{
+public:
+  SideTable() = default;
+  ~SideTable() = default;
+
+  const T* find(ValueId id) const
+  {
+    bool isPresent = id < entries.size() && entries[id].isPresent;
+    if (!isPresent) return nullptr;
+
+    return &entries[id].value;
+  }
+
+  const T& insert(ValueId id,
+                  const T& value)
+  {
+    if (id >= entries.size()) entries.resize(id + 1);
+
+    auto& entry = entries[id];
+    if (!entry.isPresent) {
+      entry.isPresent = true;
+      entry.value = value;
+
+      ++numEntries;
+    }
+
+    return entry.value;
+  }
+
+  std::size_t size() const
+  {
+    return numEntries;
+  }
+
+  void clear()
+  {
+    entries.clear();
+
+    numEntries = 0;
+  }
+
+private:
+  struct Entry
+  {
+    bool isPresent = false;
+    T value = T();
+  };
+
+  std::vector<Entry> entries;
+
+  std::size_t numEntries = 0;
+};
+
+} // namespace
+
+#endif // SIDETABLE_H
@@ -0,0 +1,67 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "TypeClassificationTable.h"
+
+#include <string>
+
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Instructions.h>
+
+#include <llvm/Support/raw_ostream.h>
+
+namespace psr {
+
+static const std::string
+getTypeName(const llvm::Type* type)
+{
+  std::string typeName;
+  llvm::raw_string_ostream typeRawOutputStream(typeName);
+  type->print(typeRawOutputStream);
+
+  return typeRawOutputStream.str();
+}
+
+void
+TypeClassificationTable::classify(const llvm::Module& module)
+{
+  for (const auto structType : module.getIdentifiedStructTypes()) {
+    getTypeClasses(structType);
+    getTypeClasses(structType->getPointerTo());
+  }
+
+  for (const auto& function : module) {
+    for (const auto& basicBlock : function) {
+      for (const auto& instruction : basicBlock) {
+        if (const auto castInst = llvm::dyn_cast<llvm::CastInst>(&instruction)) {
+          getTypeClasses(castInst->getSrcTy());
+        }
+      }
+    }
+  }
+}
+
+unsigned int
+TypeClassificationTable::getTypeClasses(const llvm::Type* type)
+{
+  const auto typeClassesEntry = typeClasses.find(type);
+  if (typeClassesEntry != typeClasses.end()) return typeClassesEntry->second;
+
+  /*
+   * Classification is done on the type name as we also want to match
+   * derived types (pointers, arrays...) of unions and va_lists.
+   */
+  const auto typeName = getTypeName(type);
+
+  unsigned int typeClass = NONE;
+
+  if (typeName.find("union") != std::string::npos) typeClass |= UNION;
+  if (typeName.find("%struct.__va_list_tag") != std::string::npos) typeClass |= VA_LIST;
+
+  typeClasses.insert({ type, typeClass });
+
+  return typeClass;
+}
+
+} // namespace
@@ -0,0 +1,76 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef TYPECLASSIFICATIONTABLE_H
+#define TYPECLASSIFICATIONTABLE_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Type.h>
+
+namespace psr {
+
+/*
+ * Properties of types we are interested in during the analysis. They used to
+ * be derived from the printed type on every query which is way too expensive
+ * for the memory location walk. Every type is classified once and the result
+ * is kept for the rest of the analysis.
+ */
+class TypeClassificationTable
+{
+public:
+  enum TypeClass : unsigned int
+  {
+    NONE = 0,
+    UNION = 1 << 0,
+    VA_LIST = 1 << 1
+  };
+
+  TypeClassificationTable() = default;
+  ~TypeClassificationTable() = default;
+
+  /*
+   * Classify all named struct types of the module (and pointers to them) as
+   * well as the source types of all casts up front. Types that are not
+   * covered are classified on first use.
+   */
+  void classify(const llvm::Module& module);
+
+  bool isUnion(const llvm::Type* type)
+  {
+    return getTypeClasses(type) & UNION;
+  }
+  bool isVaList(const llvm::Type* type)
+  {
+    return getTypeClasses(type) & VA_LIST;
+  }
+
+  /*
+   * Only lookups of classified types are safe to run concurrently.
+   */
+  bool isClassified(const llvm::Type* type) const
+  {
+    return typeClasses.find(type) != typeClasses.end();
+  }
+
+  std::size_t size() const
+  {
+    return typeClasses.size();
+  }
+  void clear()
+  {
+    typeClasses.clear();
+  }
+
+private:
+  unsigned int getTypeClasses(const llvm::Type* type);
+
+  std::unordered_map<const llvm::Type*, unsigned int> typeClasses;
+};
+
+} // namespace
+
+#endif // TYPECLASSIFICATIONTABLE_H
@@ -0,0 +1,110 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#include "ValueNumbering.h"
+
+#include <llvm/ADT/PostOrderIterator.h>
+
+#include <llvm/IR/CFG.h>
+
+namespace psr {
+
+ValueId
+ValueNumbering::insert(const llvm::Value* value)
+{
+  const auto idEntry = ids.find(value);
+  if (idEntry != ids.end()) return idEntry->second;
+
+  const ValueId id = static_cast<ValueId>(values.size());
+
+  ids.insert({ value, id });
+  values.push_back(value);
+
+  return id;
+}
+
+void
+ValueNumbering::number(const llvm::Module& module)
+{
+  for (const auto& global : module.globals()) {
+    insert(&global);
+  }
+
+  for (const auto& function : module) {
+    insert(&function);
+  }
+
+  for (const auto& function : module) {
+    number(function);
+  }
+}
+
+void
+ValueNumbering::number(const llvm::Function& function)
+{
+  bool isNewFunction = numberedFunctions.insert(&function).second;
+  if (!isNewFunction) return;
+
+  insert(&function);
+
+  for (const auto& arg : function.args()) {
+    insert(&arg);
+  }
+
+  if (function.isDeclaration()) return;
+
+  const auto numberBasicBlock = [this](const llvm::BasicBlock* basicBlock) {
+    insert(basicBlock);
+
+    for (const auto& instruction : *basicBlock) {
+      insert(&instruction);
+    }
+  };
+
+  llvm::ReversePostOrderTraversal<const llvm::Function*> rpoTraversal(&function);
+  for (const auto basicBlock : rpoTraversal) {
+    numberBasicBlock(basicBlock);
+  }
+
+  // Unreachable blocks
+  for (const auto& basicBlock : function) {
+    bool isNumbered = ids.find(&basicBlock) != ids.end();
+    if (!isNumbered) numberBasicBlock(&basicBlock);
+  }
+}
+
+ValueId
+ValueNumbering::getId(const llvm::Value* value)
+{
+  const auto idEntry = ids.find(value);
+  if (idEntry != ids.end()) return idEntry->second;
+
+  const llvm::Function* function = nullptr;
+
+  if (const auto instruction = llvm::dyn_cast<llvm::Instruction>(value)) {
+    function = instruction->getParent() ? instruction->getFunction() : nullptr;
+  }
+  else
+  if (const auto arg = llvm::dyn_cast<llvm::Argument>(value)) {
+    function = arg->getParent();
+  }
+  else
+  if (const auto basicBlock = llvm::dyn_cast<llvm::BasicBlock>(value)) {
+    function = basicBlock->getParent();
+  }
+
+  if (function) number(*function);
+
+  return insert(value);
+}
+
+void
+ValueNumbering::clear()
+{
+  ids.clear();
+  values.clear();
+  numberedFunctions.clear();
+}
+
+} // namespace
@@ -0,0 +1,65 @@
+/**
+  * @author Sebastian Roland <seroland86@gmail.com>
+  */
+
+#ifndef VALUENUMBERING_H
+#define VALUENUMBERING_H
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+namespace psr {
+
+using ValueId = unsigned int;
+
+/*
+ * Dense ids for globals, arguments, basic blocks and instructions so that
+ * per value bookkeeping can be kept in flat vectors (see SideTable). Within a
+ * function arguments come first followed by the basic blocks in reverse post
+ * order, each directly followed by its instructions. Unreachable blocks are
+ * numbered last.
+ *
+ * Values that have not been numbered up front (functions of other modules,
+ * constant expressions, detached instructions) get the next free id on their
+ * first lookup.
+ */
+class ValueNumbering
+{
+public:
+  ValueNumbering() = default;
+  ~ValueNumbering() = default;
+
+  void number(const llvm::Module& module);
+  void number(const llvm::Function& function);
+
+  ValueId getId(const llvm::Value* value);
+
+  const llvm::Value* getValue(ValueId id) const
+  {
+    return values[id];
+  }
+
+  std::size_t size() const
+  {
+    return values.size();
+  }
+  void clear();
+
+private:
+  ValueId insert(const llvm::Value* value);
+
+  llvm::DenseMap<const llvm::Value*, ValueId> ids;
+  std::vector<const llvm::Value*> values;
+
+  std::set<const llvm::Function*> numberedFunctions;
+};
+
+} // namespace
+
+#endif // VALUENUMBERING_H
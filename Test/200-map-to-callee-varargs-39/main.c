@@ -0,0 +1,42 @@
+#include <stdarg.h>
+#include <stdlib.h>
+
+extern char *getenv(const char *name);
+
+struct s1 {
+    int a;
+    char *t;
+};
+
+/*
+ * Several varargs are tainted by a single fact. Every patch (memcpy for the
+ * structs, store for the pointers) must keep the remaining tainted varargs.
+ */
+int
+foo(int n, ...)
+{
+    va_list args;
+    va_start(args, n);
+
+    struct s1 t1 = va_arg(args, struct s1);
+    char *ut1 = va_arg(args, char *);
+    char *t2 = va_arg(args, char *);
+    struct s1 t3 = va_arg(args, struct s1);
+    char *t4 = va_arg(args, char *);
+    char *ut2 = va_arg(args, char *);
+
+    va_end(args);
+
+    return 0;
+}
+
+int
+main()
+{
+    struct s1 s;
+    s.t = getenv("gude");
+
+    foo(1, s, "untainted", getenv("gude"), s, getenv("gude"), "untainted");
+
+    return 0;
+}
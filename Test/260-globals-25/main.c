@@ -0,0 +1,31 @@
+extern char *getenv(const char *name);
+
+char *g;
+
+void
+baz(char *x)
+{
+    char *y = x;
+}
+
+/*
+ * Neither foo() nor baz() reference g so the fact for g is not mapped into
+ * them. It must survive the call nevertheless.
+ */
+void
+foo(char *x)
+{
+    baz(x);
+}
+
+int
+main()
+{
+    g = getenv("gude");
+
+    foo("untainted");
+
+    char *t = g;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+extern char *getenv(const char *name);
+
+struct c {
+    char *t;
+    char *ut;
+};
+
+struct b {
+    struct c c;
+};
+
+struct a {
+    struct b b;
+};
+
+/*
+ * With a limit of 2 the fact mapped to foo() is p->b.* so the store to the
+ * deeper p->b.c.ut must not kill it. Reading p->b.c.ut is tainted as well as
+ * the summary part stands for every member below p->b.
+ */
+void
+foo(struct a *p)
+{
+    p->b.c.ut = "untaint";
+
+    char *t = p->b.c.t;
+    char *summarized = p->b.c.ut;
+}
+
+int
+main()
+{
+    struct a s;
+    s.b.c.t = getenv("gude");
+
+    foo(&s);
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+extern char *get_config_value(const char *name);
+extern char *read_secret(const char *name);
+extern char *get_other(const char *name);
+extern char *getenv(const char *name);
+
+/*
+ * Tainted functions are given by a prefix and a suffix pattern (see
+ * tainted-functions.txt). getenv() is not tainted as the list replaces
+ * the default one.
+ */
+int
+main()
+{
+    char *t1 = get_config_value("gude");
+    char *t2 = read_secret("gude");
+    char *ut1 = get_other("gude");
+    char *ut2 = getenv("gude");
+
+    char *t3 = t1;
+    char *t4 = t2;
+    char *ut3 = ut1;
+    char *ut4 = ut2;
+
+    return 0;
+}
@@ -7,6 +7,8 @@ IR_OUT='main.ll'
 
 LINES_FILE='line-numbers.txt'
 EXPECTED_LINES_FILE='expected-line-numbers.txt'
+# Optional per test environment (one VAR=value per line, e.g. MEMORY_LOCATION_SEQ_LIMIT=2)
+ENV_FILE='env'
 PHASAR_OUTPUT_FILE='out'
 HTML_INCLUDE_PHASAR_OUTPUT=1
 
@@ -19,8 +21,6 @@ PHASAR_RESULTS_FILE='results.json'
 
 SUMMARY_FILE='test-result-index.html'
 
-PREPROCESS_IR_BIN='/home/sebastian/.qt-creator-workspace/Phasar/Tools/preprocess-ir.pl'
-
 function create_html {
     rm -f ${OUT_HTML}
     echo '<!doctype html>' >> ${OUT_HTML}
@@ -126,13 +126,14 @@ do
     echo "Compiling to IR"
     ${CC} ${CFLAGS} ${SRC_IN} -o ${IR_OUT}
 
-    echo "Preprocessing IR"
-    PREPROCESSED_IR_OUT="${IR_OUT}.preprocessed"
-
-    ${PREPROCESS_IR_BIN} ${IR_OUT} ${PREPROCESSED_IR_OUT}
-
     echo "Running analysis"
-    ${PHASAR_BIN} -m ${PREPROCESSED_IR_OUT} -M 0 -D plugin --analysis-plugin ${PHASAR_PLUGIN} > ${PHASAR_OUTPUT_FILE} 2>&1
+    TEST_ENV=""
+    if [ -f ${ENV_FILE} ]; then
+        TEST_ENV=$(grep -v '^#' ${ENV_FILE})
+        echo "Using environment: ${TEST_ENV}"
+    fi
+
+    env ${TEST_ENV} ${PHASAR_BIN} -m ${IR_OUT} -M 0 -D plugin --analysis-plugin ${PHASAR_PLUGIN} > ${PHASAR_OUTPUT_FILE} 2>&1
 
     echo "Checking result"
 